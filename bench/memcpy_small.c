@@ -0,0 +1,70 @@
+#include <llv/mem.h>
+#include <llv/alloc.h>
+#include <llv/macros.h>
+#include <x86intrin.h>
+#include <string.h>
+#include <stdio.h>
+
+#define	ITERS 200000
+
+/*
+ * Cycles per call of lv_memcpy, lv_memmove and libc memcpy for each size
+ * bucket handled by the small-copy kernel. Sizes inside a bucket are
+ * rotated so the branch predictor sees a realistic mix, and source and
+ * destination offsets vary to cover misaligned copies.
+ */
+
+typedef void	*(*t_cpy)(void *, const void *, size_t);
+
+static void	*libc_memcpy(void *d, const void *s, size_t n)
+{
+	return (memcpy(d, s, n));
+}
+
+static void	*llv_memcpy(void *d, const void *s, size_t n)
+{
+	return (lv_memcpy(d, s, n));
+}
+
+static void	*llv_memmove(void *d, const void *s, size_t n)
+{
+	return (lv_memmove(d, s, n));
+}
+
+static double	bench(t_cpy f, char *dst, const char *src, size_t lo, size_t hi)
+{
+	size_t	span = hi - lo + 1;
+	t_u64	start;
+	t_u64	end;
+
+	for (size_t i = 0; i < 1000; i++)
+		f(dst + (i & 15), src + (i * 7 & 15), lo + i % span);
+	start = __rdtsc();
+	for (size_t i = 0; i < ITERS; i++)
+		f(dst + (i & 15), src + (i * 7 & 15), lo + i % span);
+	end = __rdtsc();
+	return ((double)(end - start) / ITERS);
+}
+
+int	main(void)
+{
+	const size_t	buckets[][2] = {{0, 0}, {1, 3}, {4, 7}, {8, 15}, {16, 31},
+		{32, 63}, {64, 127}, {128, 256}};
+	LV_DEFER char	*src = lv_alloc(512);
+	LV_DEFER char	*dst = lv_alloc(512);
+
+	memset(src, 'x', 512);
+	printf("%-10s %12s %12s %12s\n", "bytes", "lv_memcpy", "lv_memmove",
+		"memcpy");
+	for (size_t b = 0; b < sizeof(buckets) / sizeof(*buckets); b++)
+	{
+		char	label[16];
+
+		snprintf(label, sizeof(label), "%zu-%zu", buckets[b][0], buckets[b][1]);
+		printf("%-10s %12.2f %12.2f %12.2f\n", label,
+			bench(llv_memcpy, dst, src, buckets[b][0], buckets[b][1]),
+			bench(llv_memmove, dst, src, buckets[b][0], buckets[b][1]),
+			bench(libc_memcpy, dst, src, buckets[b][0], buckets[b][1]));
+	}
+	return (0);
+}
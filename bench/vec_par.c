@@ -0,0 +1,144 @@
+#include <llv/pool.h>
+#include <llv/vec.h>
+#include <llv/alloc.h>
+#include <llv/macros.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+
+#define	N		((size_t)1 << 23)
+#define	RUNS	3
+
+/*
+ * Milliseconds to sort and to sum N random 32-bit keys with lv_vec_sort
+ * and lv_vec_reduce, then with lv_vec_par_sort and lv_vec_par_reduce on
+ * pools of 1, 2, 4 ... up to the number of online CPUs, best of RUNS.
+ * Speedups are against the serial versions; results are checked
+ * against them too.
+ */
+
+static int	cmp_u32(const void *a, const void *b)
+{
+	t_u32	x = *(const t_u32 *)a;
+	t_u32	y = *(const t_u32 *)b;
+
+	return ((x > y) - (x < y));
+}
+
+static void	sum_u32(void *acc, const void *elem, void *ctx)
+{
+	(void)ctx;
+	*(t_u64 *)acc += *(const t_u32 *)elem;
+}
+
+static void	sum_u64(void *acc, const void *part, void *ctx)
+{
+	(void)ctx;
+	*(t_u64 *)acc += *(const t_u64 *)part;
+}
+
+static double	elapsed(struct timespec *a)
+{
+	struct timespec	b;
+
+	clock_gettime(CLOCK_MONOTONIC, &b);
+	return ((double)(b.tv_sec - a->tv_sec) * 1e3
+		+ (double)(b.tv_nsec - a->tv_nsec) / 1e6);
+}
+
+static double	bench_sort(t_pool *pool, t_vec *v, const t_u32 *input,
+					const t_u32 *ref)
+{
+	struct timespec	a;
+	double			best = 1e30;
+	double			ms;
+
+	for (int r = 0; r < RUNS; r++)
+	{
+		memcpy(v->data, input, N * sizeof(t_u32));
+		clock_gettime(CLOCK_MONOTONIC, &a);
+		if (pool)
+			lv_vec_par_sort(pool, v, cmp_u32);
+		else
+			lv_vec_sort(v, cmp_u32);
+		ms = elapsed(&a);
+		if (ms < best)
+			best = ms;
+	}
+	if (ref && memcmp(v->data, ref, N * sizeof(t_u32)))
+		printf("MISMATCH\n");
+	return (best);
+}
+
+static double	bench_reduce(t_pool *pool, t_vec *v, t_u64 *sum)
+{
+	struct timespec	a;
+	double			best = 1e30;
+	double			ms;
+
+	for (int r = 0; r < RUNS; r++)
+	{
+		*sum = 0;
+		clock_gettime(CLOCK_MONOTONIC, &a);
+		if (pool)
+			lv_vec_par_reduce(pool, v, sum, sizeof(*sum), sum_u32, sum_u64,
+				NULL);
+		else
+			lv_vec_reduce(v, sum, sum_u32, NULL);
+		ms = elapsed(&a);
+		if (ms < best)
+			best = ms;
+	}
+	return (best);
+}
+
+int	main(void)
+{
+	t_vec			v = lv_vec(N, sizeof(t_u32));
+	LV_DEFER t_u32	*input = lv_alloc(N * sizeof(t_u32));
+	LV_DEFER t_u32	*ref = lv_alloc(N * sizeof(t_u32));
+	size_t			cpus = (size_t)sysconf(_SC_NPROCESSORS_ONLN);
+	t_u64			x = 88172645463325252ULL;
+	t_u64			sum;
+	t_u64			par;
+	double			sort_ms;
+	double			reduce_ms;
+
+	for (size_t i = 0; i < N; i++)
+	{
+		x ^= x << 13;
+		x ^= x >> 7;
+		x ^= x << 17;
+		input[i] = (t_u32)x;
+	}
+	v.size = N;
+	sort_ms = bench_sort(NULL, &v, input, NULL);
+	memcpy(ref, v.data, N * sizeof(t_u32));
+	memcpy(v.data, input, N * sizeof(t_u32));
+	reduce_ms = bench_reduce(NULL, &v, &sum);
+	printf("%zu u32 keys, LV_PAR_CHUNK %zu, LV_PAR_MIN %d\n", N,
+		LV_PAR_CHUNK, LV_PAR_MIN);
+	printf("%-8s %12s %8s %12s %8s\n", "threads", "sort (ms)", "speedup",
+		"reduce (ms)", "speedup");
+	printf("%-8s %12.1f %8s %12.2f %8s\n", "serial", sort_ms, "", reduce_ms,
+		"");
+	for (size_t t = 1; t <= cpus; t = (t * 2 > cpus && t < cpus) ? cpus : t * 2)
+	{
+		t_pool	*pool = lv_pool_create(t, 0);
+		double	s;
+		double	r;
+
+		memcpy(v.data, input, N * sizeof(t_u32));
+		r = bench_reduce(pool, &v, &par);
+		if (par != sum)
+			printf("MISMATCH\n");
+		s = bench_sort(pool, &v, input, ref);
+		printf("%-8zu %12.1f %7.2fx %12.2f %7.2fx\n", t, s, sort_ms / s, r,
+			reduce_ms / r);
+		lv_pool_destroy(pool);
+	}
+	lv_vec_free(&v);
+	return (0);
+}
@@ -0,0 +1,121 @@
+#include <llv/vec.h>
+#include <llv/alloc.h>
+#include <llv/macros.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <time.h>
+
+#define	N		((size_t)1 << 22)
+#define	RUNS	5
+
+/*
+ * Milliseconds to sort N random keys with libc qsort, lv_vec_sort and
+ * the radix sorts, for 32 and 64-bit keys, best of RUNS. Every run sorts
+ * a fresh copy of the same input; results are checked against qsort.
+ */
+
+typedef void	(*t_sort)(t_vec *v);
+
+static int	cmp_u32(const void *a, const void *b)
+{
+	t_u32	x = *(const t_u32 *)a;
+	t_u32	y = *(const t_u32 *)b;
+
+	return ((x > y) - (x < y));
+}
+
+static int	cmp_u64(const void *a, const void *b)
+{
+	t_u64	x = *(const t_u64 *)a;
+	t_u64	y = *(const t_u64 *)b;
+
+	return ((x > y) - (x < y));
+}
+
+static void	libc_u32(t_vec *v)
+{
+	qsort(v->data, v->size, v->sizeof_type, cmp_u32);
+}
+
+static void	libc_u64(t_vec *v)
+{
+	qsort(v->data, v->size, v->sizeof_type, cmp_u64);
+}
+
+static void	intro_u32(t_vec *v)
+{
+	lv_vec_sort(v, cmp_u32);
+}
+
+static void	intro_u64(t_vec *v)
+{
+	lv_vec_sort(v, cmp_u64);
+}
+
+static void	radix_u32(t_vec *v)
+{
+	lv_vec_radix_sort_u32(v);
+}
+
+static void	radix_u64(t_vec *v)
+{
+	lv_vec_radix_sort_u64(v);
+}
+
+static double	bench(t_sort f, t_vec *v, const void *input, const void *ref)
+{
+	struct timespec	a;
+	struct timespec	b;
+	double			best = 1e30;
+	double			ms;
+
+	for (int r = 0; r < RUNS; r++)
+	{
+		memcpy(v->data, input, v->size * v->sizeof_type);
+		clock_gettime(CLOCK_MONOTONIC, &a);
+		f(v);
+		clock_gettime(CLOCK_MONOTONIC, &b);
+		ms = (double)(b.tv_sec - a.tv_sec) * 1e3
+			+ (double)(b.tv_nsec - a.tv_nsec) / 1e6;
+		if (ms < best)
+			best = ms;
+	}
+	if (memcmp(v->data, ref, v->size * v->sizeof_type))
+		printf("MISMATCH\n");
+	return (best);
+}
+
+static void	row(const char *label, size_t w, t_sort sorts[3])
+{
+	t_vec			v = lv_vec(N, w);
+	LV_DEFER t_u8	*input = lv_alloc(N * w);
+	LV_DEFER t_u8	*ref = lv_alloc(N * w);
+	t_u64			x = 88172645463325252ULL;
+
+	for (size_t i = 0; i < N * w; i++)
+	{
+		x ^= x << 13;
+		x ^= x >> 7;
+		x ^= x << 17;
+		input[i] = (t_u8)x;
+	}
+	v.size = N;
+	memcpy(ref, input, N * w);
+	sorts[0](&(t_vec){.data = ref, .size = N, .alloc_size = N,
+		.sizeof_type = w});
+	printf("%-10s %12.1f %12.1f %12.1f\n", label,
+		bench(sorts[0], &v, input, ref),
+		bench(sorts[1], &v, input, ref),
+		bench(sorts[2], &v, input, ref));
+	lv_vec_free(&v);
+}
+
+int	main(void)
+{
+	printf("%-10s %12s %12s %12s\n", "keys (ms)", "qsort", "lv_vec_sort",
+		"radix");
+	row("u32", 4, (t_sort[3]){libc_u32, intro_u32, radix_u32});
+	row("u64", 8, (t_sort[3]){libc_u64, intro_u64, radix_u64});
+	return (0);
+}
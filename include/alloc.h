@@ -25,6 +25,7 @@
 # include <sys/types.h>
 # include <stdint.h>
 # include <stdarg.h>
+# include <stdbool.h>
 # include "mem.h"
 # include "macros.h"
 # include "structs.h"
@@ -34,11 +35,85 @@
 # endif
 
 # ifndef DEFAULT_ARENA_SIZE
-#  define DEFAULT_ARENA_SIZE (size_t)(sizeof(size_t) * 2049)
+#  define DEFAULT_ARENA_SIZE (size_t)4096
 # endif
 
+# ifndef LV_ARENA_MAX_CHUNK
+#  define LV_ARENA_MAX_CHUNK ((size_t)1 << 20)
+# endif
+
+# ifndef LV_ARENA_CACHE
+#  define LV_ARENA_CACHE 8
+# endif
+
+# define LV_ARENA_CLASSES	24
+# define LV_ARENA_ALIGN		64
+
+/*
+ * Size-class slab allocator. Requests up to LV_SLAB_MAX bytes made
+ * through `lv_alloc` are served from it when LV_ALLOC_SLAB is 1.
+ */
+
+# ifndef LV_ALLOC_SLAB
+#  define LV_ALLOC_SLAB 1
+# endif
+
+# ifndef LV_SLAB_REGION
+#  define LV_SLAB_REGION ((size_t)1 << 30)
+# endif
+
+_Static_assert(LV_SLAB_REGION <= ((size_t)1 << 32),
+	"LV_SLAB_REGION: slab free lists store 32-bit region offsets");
+
+# ifndef LV_SLAB_TCACHE
+#  define LV_SLAB_TCACHE 128
+# endif
+
+/*
+ * Requests of at least LV_HUGE_THRESHOLD bytes bypass malloc and get
+ * their own anonymous mapping, backed by transparent huge pages.
+ */
+
+# ifndef LV_HUGE_THRESHOLD
+#  define LV_HUGE_THRESHOLD ((size_t)32 << 20)
+# endif
+
+# define LV_HUGE_PAGE		((size_t)2 << 20)
+# define LV_HUGE_HDR		64
+
+# define LV_ALLOC_HUGE		0x1
+# define LV_ALLOC_POPULATE	0x2
+
+/*
+ * Allocation statistics and sampled call sites (see `lv_alloc_stats`).
+ * Compiled in with -DLV_ALLOC_STATS=1; otherwise every hook folds away.
+ */
+
+# ifndef LV_ALLOC_STATS
+#  define LV_ALLOC_STATS 0
+# endif
+
+# ifndef LV_STATS_FLUSH
+#  define LV_STATS_FLUSH ((ssize_t)64 << 10)
+# endif
+
+# ifndef LV_TRACE_RING
+#  define LV_TRACE_RING 256
+# endif
+
+# define LV_SLAB_MIN		16
+# define LV_SLAB_MAX		2048
+# define LV_SLAB_CLASSES	8
+# define LV_SLAB_SHIFT		16
+
 void			*lv_alloc(size_t size);
+void			*lv_alloc_align(size_t size, size_t align);
+void			*lv_alloc_ex(size_t size, int flags);
 void			lv_free(void **ptr);
+void			*lv_slab_alloc(size_t size);
+void			lv_slab_free(void *ptr);
+bool			lv_slab_owns(const void *ptr);
+size_t			lv_slab_size(const void *ptr);
 void			lv_free_array(void ***arr);
 void			lv_defer(void *ptr);
 void			lv_defer_arr(void ***ptr);
@@ -49,4 +124,28 @@ void			*lv_realloc(void *ptr, size_t n, size_t size);
 void			*lv_recalloc(void *ptr, size_t n, size_t size);
 void			*lv_arena(size_t size);
 void			lv_free_arena(t_arena *arena);
+void			*_lv_regrow(void *ptr, size_t n, size_t size, bool zero);
+void			*_lv_huge_alloc(size_t size, int flags);
+void			*_lv_huge_resize(void *ptr, size_t size);
+void			_lv_huge_free(void *ptr);
+bool			_lv_huge_owns(const void *ptr);
+size_t			_lv_huge_size(const void *ptr);
+t_alloc_stats	lv_alloc_stats(void);
+void			lv_alloc_trace(size_t period);
+size_t			lv_alloc_samples(t_alloc_sample *out, size_t max);
+size_t			_lv_stat_block(const void *ptr);
+void			_lv_stat_alloc(const void *ptr, size_t size);
+void			_lv_stat_free(const void *ptr);
+void			_lv_stat_resize(size_t old, size_t size, bool moved,
+					size_t copied);
+void			_lv_stat_chunk(int delta);
+t_arena			*lv_arena_create(size_t size);
+void			*lv_arena_alloc(t_arena *arena, size_t size);
+void			*lv_arena_alloc_aligned(t_arena *arena, size_t size,
+					size_t align);
+void			lv_arena_reset(t_arena *arena);
+void			lv_arena_destroy(t_arena *arena);
+t_arena_mark	lv_arena_mark(t_arena *arena);
+void			lv_arena_rewind(t_arena_mark mark);
+void			lv_arena_scope_end(t_arena_mark *mark);
 #endif
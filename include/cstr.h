@@ -46,5 +46,7 @@ void			lv_striteri(char *str, void (*f)(unsigned int, char *));
 char			*lv_strjoin(const char *s1, const char *s2);
 char			*lv_substr(const char *s, unsigned int start, size_t len);
 char			**lv_split(const char *str, char set);
+char			**lv_split_any(const char *str, const char *set);
+char			*lv_strpbrk(const char *str, const char *set);
 int				lv_strcmp(const char *a, const char *b);
 #endif
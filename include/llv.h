@@ -30,6 +30,7 @@
 # include "lst.h"
 # include "conv.h"
 # include "vec.h"
+# include "pool.h"
 # include "macros.h"
 
 #endif
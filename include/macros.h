@@ -51,6 +51,14 @@
 #  endif
 # endif
 
+# ifndef LV_ARENA_SCOPE
+#  ifdef __GNUC__
+#    define LV_ARENA_SCOPE __attribute__((cleanup(lv_arena_scope_end)))
+#  else
+#    define LV_ARENA_SCOPE
+#  endif
+# endif
+
 # ifndef LV_DEFER
 #  ifdef __GNUC__
 #    define LV_DEFER __attribute__((cleanup(lv_defer)))
@@ -91,26 +99,26 @@
 #  endif
 # endif
 
-# ifndef LV_SIMD
-#  if defined(__AVX512F__) && defined(__AVX512BW__) && defined(__AVX512VL__)
-#   define LV_SIMD __attribute__((target("avx512f,avx512bw,avx512vl")))
-#  elif defined(__AVX2__) && defined(__FMA__) && defined(__BMI2__)
-#   define LV_SIMD __attribute__((target("avx2,fma,bmi2")))
-#  elif defined(__AVX2__)
-#   define LV_SIMD __attribute__((target("avx2")))
-#  elif defined(__SSE4_2__)
-#   define LV_SIMD __attribute__((target("sse4.2")))
-#  elif defined(__SSE4_1__)
-#   define LV_SIMD __attribute__((target("sse4.1")))
-#  elif defined(__SSSE3__)
-#   define LV_SIMD __attribute__((target("ssse3")))
-#  elif defined(__SSE2__)
-#   define LV_SIMD __attribute__((target("sse2")))
+# ifndef LV_TARGET
+#  ifdef __GNUC__
+#   define LV_TARGET(isa) __attribute__((target(isa)))
 #  else
-#   define LV_SIMD
+#   define LV_TARGET(isa)
 #  endif
 # endif
 
+# ifndef LV_SSE2
+#  define LV_SSE2 LV_TARGET("sse2")
+# endif
+
+# ifndef LV_AVX2
+#  define LV_AVX2 LV_TARGET("avx2")
+# endif
+
+# ifndef LV_AVX512
+#  define LV_AVX512 LV_TARGET("avx512f,avx512bw,avx512vl")
+# endif
+
 # ifndef LV_INLINE_HOT
 #  ifdef __GNUC__
 #    define LV_INLINE_HOT __attribute__((always_inline)) __attribute__((hot))
@@ -149,4 +157,8 @@
 #  define LV_MAX(x, y) ((x) > (y) ? (x) : (y))
 # endif
 
+# ifndef LV_MIN
+#  define LV_MIN(x, y) ((x) < (y) ? (x) : (y))
+# endif
+
 #endif
@@ -28,13 +28,7 @@
 # include "alloc.h"
 # include "structs.h"
 # include "macros.h"
-# ifdef __SSE2__
-#  include <emmintrin.h>
-# endif
-
-# ifdef __AVX2__
-#  include <immintrin.h>
-# endif
+# include <immintrin.h>
 
 # define LONES_64 0x0101010101010101ULL
 # define HIGHS_64 0x8080808080808080ULL
@@ -42,12 +36,72 @@
 # define LONES_32  0x01010101U
 # define HIGHS_32  0x80808080U
 
+# define LV_SMALL_COPY	256
+
+/*
+ * Needles up to this length are searched with the SIMD first/last byte
+ * filter; longer ones go through Two-Way.
+ */
+
+# define LV_SEARCH_SHORT	32
+
+/*
+ * Unaligned, aliasing-safe views for loading 2/4/8 bytes from any
+ * address without going through a byte loop.
+ */
+
+typedef uint16_t __attribute__((aligned(1), may_alias))	t_u16u;
+typedef t_u32 __attribute__((aligned(1), may_alias))	t_u32u;
+typedef t_u64 __attribute__((aligned(1), may_alias))	t_u64u;
+
+# define LV_SET_NOT		0x1
+# define LV_SET_REV		0x2
+
+# define LV_BYTESET_HAS(s, c) \
+	(((s)->bits[(t_u8)(c) >> 6] >> ((t_u8)(c) & 63)) & 1)
+
+# define LV_CPU_SSE2	0x1U
+# define LV_CPU_AVX2	0x2U
+# define LV_CPU_AVX512	0x4U
+
+/*
+ * One entry per dispatched routine, filled at load time by
+ * `lv_cpu_dispatch` with the widest variant the running CPU supports.
+ */
+
+typedef struct s_mem_dispatch
+{
+	void		*(*cpy)(void *__restrict__, const void *__restrict__, size_t);
+	void		*(*cpy_nt)(void *__restrict__, const void *__restrict__, size_t);
+	void		*(*set)(void *__restrict__, int, size_t);
+	void		*(*move)(void *, const void *, size_t);
+	ssize_t		(*cmp)(const void *, const void *, size_t);
+	bool		(*eq)(const void *, const void *, size_t);
+	void		*(*chr)(const void *, int, size_t);
+	void		*(*rchr)(const void *, int, size_t);
+	void		*(*any)(const void *, size_t, const t_byteset *, int);
+	size_t		(*len)(const char *);
+	void		*(*find)(const void *, size_t, const void *, size_t);
+	void		(*rev)(void *, size_t, size_t);
+}	t_mem_dispatch;
+
+extern t_mem_dispatch	g_lv_mem;
+
+/*
+ * Copies and fills of at least this many bytes bypass the cache with
+ * non-temporal stores. Set at load time from the last level cache size.
+ */
+
+extern size_t			g_lv_nt_threshold;
+
 // Actual api
 
 void			lv_bzero(void *__restrict__ ptr, size_t n);
 void			*lv_memset(void *__restrict__ s, int c, size_t n);
 void			*lv_memcpy(void *__restrict__ dest,
 					const void *__restrict__ src, size_t n);
+void			*lv_memcpy_nt(void *__restrict__ dest,
+					const void *__restrict__ src, size_t n);
 void			lv_memtake(void *__restrict__ dest,
 					void *__restrict__ src, size_t n);
 t_u8			lv_memswap(void *__restrict__ p1,
@@ -58,12 +112,32 @@ t_u8			lv_memswap_extern(void *__restrict__ p1,
 void			*lv_memmove(void *__restrict__ dest,
 					const void *__restrict__ src, size_t n);
 void			*lv_memchr(const void *__restrict__ ptr, int c, size_t n);
+void			*lv_memrchr(const void *__restrict__ ptr, int c, size_t n);
 ssize_t			lv_memcmp(void *__restrict__ dest,
 					const void *__restrict__ src, size_t n);
+void			lv_byteset_init(t_byteset *set, const void *chars, size_t n);
+void			*lv_memchr_any(const void *ptr, size_t n, const t_byteset *set);
+void			*lv_memchr_not(const void *ptr, size_t n, const t_byteset *set);
+void			*lv_memrchr_any(const void *ptr, size_t n,
+					const t_byteset *set);
+void			*lv_memrchr_not(const void *ptr, size_t n,
+					const t_byteset *set);
+bool			lv_memeq(const void *__restrict__ a,
+					const void *__restrict__ b, size_t n);
+void			*lv_memmem(const void *hay, size_t n,
+					const void *needle, size_t len);
+void			lv_searcher_init(t_searcher *s, const void *needle,
+					size_t len);
+void			*lv_searcher_find(const t_searcher *s, const void *hay,
+					size_t n);
+void			lv_memrev(void *ptr, size_t n, size_t width);
 void			*lv_memffb(const void *__restrict__ ptr,
 					t_u8 x, size_t n);
 void			*lv_memclone(void *__restrict__ ptr, size_t size);
 void			*lv_memformat(void *ptr, size_t size);
+t_u32			lv_cpu_features(void);
+void			lv_cpu_dispatch(t_u32 features);
+size_t			lv_cpu_cache_size(void);
 
 /*
  *
@@ -71,48 +145,6 @@ void			*lv_memformat(void *ptr, size_t size);
  *
  */
 
-// COPY 
-
-void			_copy_u8_fwd(void *__restrict__ dest,
-					const void *__restrict__ src,
-					size_t *__restrict__ n, size_t *__restrict__ i);
-void			_copy_u32_fwd(void *__restrict__ dest,
-					const void *__restrict__ src,
-					size_t *__restrict__ n, size_t *__restrict__ i);
-void			_copy_u64_fwd(void *__restrict__ dest,
-					const void *__restrict__ src,
-					size_t *__restrict__ n, size_t *__restrict__ i);
-void			_copy_u128_fwd(void *__restrict__ dest,
-					const void *__restrict__ src,
-					size_t *__restrict__ n, size_t *__restrict__ i);
-void			_copy_u8_bw(void *__restrict__ dest,
-					const void *__restrict__ src,
-					size_t *__restrict__ n, size_t *__restrict__ i);
-void			_copy_u32_bw(void *__restrict__ dest,
-					const void *__restrict__ src,
-					size_t *__restrict__ n, size_t *__restrict__ i);
-void			_copy_u64_bw(void *__restrict__ dest,
-					const void *__restrict__ src,
-					size_t *__restrict__ n, size_t *__restrict__ i);
-void			_copy_u128_bw(void *__restrict__ dest,
-					const void *__restrict__ src,
-					size_t *__restrict__ n, size_t *__restrict__ i);
-
-// OVERWRITING
-
-void			_write_u8_fwd(void *__restrict__ dest,
-					t_u8 x,
-					size_t *__restrict__ n, size_t *__restrict__ i);
-void			_write_u32_fwd(void *__restrict__ dest,
-					t_u32 x,
-					size_t *__restrict__ n, size_t *__restrict__ i);
-void			_write_u64_fwd(void *__restrict__ dest,
-					t_u64 x,
-					size_t *__restrict__ n, size_t *__restrict__ i);
-void			_write_u128_fwd(void *__restrict__ dest,
-					t_u128 x,
-					size_t *__restrict__ n, size_t *__restrict__ i);
-
 // LOOKUP
 
 void			*_look4_u8_fwd(void *__restrict__ ptr,
@@ -165,6 +197,60 @@ int				__hasz128(t_u128 x);
 int				__hasz64(t_u64 x);
 t_u128			__populate(t_u8 y);
 
+// DISPATCH VARIANTS
+
+void			*_lv_memcpy_small(void *dest, const void *src, size_t n);
+
+void			*_lv_memcpy_sse2(void *__restrict__ dest,
+					const void *__restrict__ src, size_t n);
+void			*_lv_memcpy_avx2(void *__restrict__ dest,
+					const void *__restrict__ src, size_t n);
+void			*_lv_memcpy_avx512(void *__restrict__ dest,
+					const void *__restrict__ src, size_t n);
+void			*_lv_memcpy_nt_sse2(void *__restrict__ dest,
+					const void *__restrict__ src, size_t n);
+void			*_lv_memcpy_nt_avx2(void *__restrict__ dest,
+					const void *__restrict__ src, size_t n);
+void			*_lv_memcpy_nt_avx512(void *__restrict__ dest,
+					const void *__restrict__ src, size_t n);
+void			*_lv_memset_sse2(void *__restrict__ dest, int c, size_t n);
+void			*_lv_memset_avx2(void *__restrict__ dest, int c, size_t n);
+void			*_lv_memset_avx512(void *__restrict__ dest, int c, size_t n);
+void			*_lv_memmove_sse2(void *dest, const void *src, size_t n);
+void			*_lv_memmove_avx2(void *dest, const void *src, size_t n);
+void			*_lv_memmove_avx512(void *dest, const void *src, size_t n);
+ssize_t			_lv_memcmp_sse2(const void *dest, const void *src, size_t n);
+ssize_t			_lv_memcmp_avx2(const void *dest, const void *src, size_t n);
+ssize_t			_lv_memcmp_avx512(const void *dest, const void *src,
+					size_t n);
+bool			_lv_memeq_sse2(const void *a, const void *b, size_t n);
+bool			_lv_memeq_avx2(const void *a, const void *b, size_t n);
+bool			_lv_memeq_avx512(const void *a, const void *b, size_t n);
+void			*_lv_memchr_sse2(const void *ptr, int c, size_t n);
+void			*_lv_memchr_avx2(const void *ptr, int c, size_t n);
+void			*_lv_memchr_avx512(const void *ptr, int c, size_t n);
+void			*_lv_memrchr_sse2(const void *ptr, int c, size_t n);
+void			*_lv_memrchr_avx2(const void *ptr, int c, size_t n);
+void			*_lv_memrchr_avx512(const void *ptr, int c, size_t n);
+void			*_lv_memchr_any_sse2(const void *ptr, size_t n,
+					const t_byteset *set, int mode);
+void			*_lv_memchr_any_avx2(const void *ptr, size_t n,
+					const t_byteset *set, int mode);
+void			*_lv_memchr_any_avx512(const void *ptr, size_t n,
+					const t_byteset *set, int mode);
+size_t			_lv_strlen_sse2(const char *str);
+size_t			_lv_strlen_avx2(const char *str);
+size_t			_lv_strlen_avx512(const char *str);
+void			*_lv_memmem_sse2(const void *hay, size_t n,
+					const void *needle, size_t len);
+void			*_lv_memmem_avx2(const void *hay, size_t n,
+					const void *needle, size_t len);
+void			*_lv_memmem_avx512(const void *hay, size_t n,
+					const void *needle, size_t len);
+void			_lv_memrev_sse2(void *ptr, size_t n, size_t w);
+void			_lv_memrev_avx2(void *ptr, size_t n, size_t w);
+void			_lv_memrev_avx512(void *ptr, size_t n, size_t w);
+
 // ALIGNMIENT & CHECKZ
 t_u8			lv_memctz_u32(t_u32 x);
 t_u8			lv_memctz_u64(t_u64 x);
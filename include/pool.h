@@ -0,0 +1,98 @@
+/**
+ * pool.h
+ *
+ * Copyright (C) 2025 lvzrr <lvzrr@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General
+ * Public License along with this program. If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef POOL_H
+# define POOL_H
+
+# include <pthread.h>
+# include <stdbool.h>
+# include "structs.h"
+# include "vec.h"
+
+/*
+ * Tasks handed to the pool by the lv_vec_par_* functions cover about
+ * LV_PAR_CHUNK bytes of data each, so a task's working set stays in the
+ * core's L2 cache. Vectors of fewer than LV_PAR_MIN elements are
+ * processed on the calling thread.
+ */
+
+# ifndef LV_PAR_CHUNK
+#  define LV_PAR_CHUNK ((size_t)64 << 10)
+# endif
+
+# ifndef LV_PAR_MIN
+#  define LV_PAR_MIN 16384
+# endif
+
+/*
+ * `lv_pool_create` flag: run every task on the calling thread, in index
+ * order, so parallel code behaves exactly like its serial version.
+ */
+
+# define LV_POOL_DETERMINISTIC	0x1
+
+/*
+ * One queue per participant (the caller is slot 0): the range of task
+ * indices it still owns. The owner takes from the front, thieves split
+ * off the back half.
+ */
+
+typedef struct s_pool_queue
+{
+	pthread_mutex_t	lock;
+	size_t			lo;
+	size_t			hi;
+}	__attribute__((aligned(64)))	t_pool_queue;
+
+typedef struct s_pool
+{
+	pthread_mutex_t	lock;
+	pthread_cond_t	wake;
+	pthread_cond_t	done;
+	pthread_mutex_t	run;
+	pthread_t		*threads;
+	t_pool_queue	*queues;
+	size_t			workers;
+	int				flags;
+	bool			stop;
+	size_t			generation;
+	size_t			active;
+	size_t			pending;
+	void			(*fn)(size_t task, void *ctx);
+	void			*ctx;
+}	t_pool;
+
+t_pool		*lv_pool_create(size_t threads, int flags);
+void		lv_pool_destroy(t_pool *pool);
+t_pool		*lv_pool_default(void);
+size_t		lv_pool_size(const t_pool *pool);
+void		lv_pool_run(t_pool *pool, size_t tasks,
+				void (*fn)(size_t task, void *ctx), void *ctx);
+void		lv_vec_par_for(t_pool *pool, t_vec *v,
+				void (*f)(void *chunk, size_t n, size_t first, void *ctx),
+				void *ctx);
+bool		lv_vec_par_reduce(t_pool *pool, const t_vec *v, void *acc,
+				size_t acc_size,
+				void (*f)(void *acc, const void *elem, void *ctx),
+				void (*merge)(void *acc, const void *part, void *ctx),
+				void *ctx);
+bool		lv_vec_par_sort(t_pool *pool, t_vec *v,
+				int (*cmp)(const void *, const void *));
+#endif
@@ -31,11 +31,31 @@ typedef uint64_t		t_u64;
 typedef __uint128_t		t_u128;
 typedef uintptr_t		t_uptr;
 
+/*
+ * t_string keeps strings of up to LV_TSTR_SSO bytes inline, in `sso`
+ * (null-terminated, unused bytes zero). Longer ones spill to a heap
+ * buffer of `alloc_size` bytes at `data`, and `heap` is set. `heap`
+ * overlaps the last byte of `sso`, which is always zero for an inline
+ * string, so a zeroed t_string is a valid empty one. `len` is valid in
+ * both cases; go through `lv_tstr_borrow` for the bytes.
+ */
+
+# define LV_TSTR_SSO 23
+
 LV_STRUCT(s_string, 32,
 {
 	size_t	len;
-	size_t	alloc_size;
-	char	*data;
+	union
+	{
+		struct
+		{
+			size_t	alloc_size;
+			char	*data;
+			t_u8	pad[7];
+			t_u8	heap;
+		};
+		char	sso[LV_TSTR_SSO + 1];
+	};
 }, t_string)
 
 LV_STRUCT(s_vec, 32,
@@ -46,12 +66,83 @@ LV_STRUCT(s_vec, 32,
 	size_t	sizeof_type;
 }, t_vec)
 
+LV_STRUCT(s_byteset, 32,
+{
+	t_u64	bits[4];
+	t_u8	lo[2][16];
+}, t_byteset)
+
+LV_STRUCT(s_searcher, 32,
+{
+	const t_u8	*needle;
+	size_t		len;
+	size_t		ms;
+	size_t		period;
+	size_t		mem0;
+	size_t		shift[256];
+}, t_searcher)
+
 LV_STRUCT(s_arena, 32,
 {
 	size_t			size;
 	size_t			offset;
 	struct s_arena	*next;
 	void			*pool;
+	struct s_arena	*current;
 }, t_arena)
 
+LV_STRUCT(s_arena_mark, 8,
+{
+	t_arena	*arena;
+	t_arena	*chunk;
+	size_t	offset;
+}, t_arena_mark)
+
+/*
+ * Allocation statistics (see `lv_alloc_stats`). `by_class[c]` counts
+ * requests of (2^(c-1), 2^c] bytes.
+ */
+
+# define LV_STATS_CLASSES	64
+# define LV_TRACE_DEPTH		8
+
+LV_STRUCT(s_alloc_stats, 32,
+{
+	int		enabled;
+	size_t	live;
+	size_t	peak;
+	size_t	allocs;
+	size_t	frees;
+	size_t	by_class[LV_STATS_CLASSES];
+	size_t	extend_inplace;
+	size_t	extend_copies;
+	size_t	bytes_copied;
+	size_t	arena_chunks;
+}, t_alloc_stats)
+
+LV_STRUCT(s_alloc_shard, 64,
+{
+	size_t					bytes_alloc;
+	size_t					bytes_freed;
+	size_t					allocs;
+	size_t					frees;
+	size_t					by_class[LV_STATS_CLASSES];
+	size_t					extend_inplace;
+	size_t					extend_copies;
+	size_t					bytes_copied;
+	size_t					chunks_new;
+	size_t					chunks_freed;
+	ssize_t					pending;
+	size_t					countdown;
+	int						in_use;
+	struct s_alloc_shard	*next;
+}, t_alloc_shard)
+
+LV_STRUCT(s_alloc_sample, 8,
+{
+	size_t	size;
+	int		depth;
+	void	*frames[LV_TRACE_DEPTH];
+}, t_alloc_sample)
+
 #endif
@@ -22,13 +22,14 @@
 # define TSTR_H
 # include <sys/types.h>
 # include <stdlib.h>
+# include <stdbool.h>
 # include "structs.h"
 # include "mem.h"
 # include "alloc.h"
 # include "cstr.h"
 
 t_string		lv_tstr_from_cstr(const char *str);
-t_string		 lv_tstr_from_slice(char *s, size_t n);
+t_string		lv_tstr_from_slice(char *s, size_t n);
 char			*lv_tstr_dup_cstr(t_string *str);
 t_string		lv_tstr_new(ssize_t len);
 void			lv_tstr_pushstr(t_string *str, const char *s);
@@ -46,4 +47,24 @@ void			lv_tstr_repeat(t_string *str, const char *chunk,
 void			lv_tstr_insert(t_string *str, const char *insert,
 					size_t position);
 void			lv_tstr_pushslice(t_string *str, const char *s, size_t n);
+bool			_lv_tstr_grow(t_string *str, size_t size);
+
+/*
+ * The bytes of `str` and their capacity (null terminator included),
+ * inline or on the heap.
+ */
+
+static inline char	*_lv_tstr_ptr(t_string *str)
+{
+	if (str->heap)
+		return (str->data);
+	return (str->sso);
+}
+
+static inline size_t	_lv_tstr_cap(const t_string *str)
+{
+	if (str->heap)
+		return (str->alloc_size);
+	return (LV_TSTR_SSO + 1);
+}
 #endif
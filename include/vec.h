@@ -22,10 +22,28 @@
 # define VEC_H
 
 # include <stddef.h>
+# include <stdbool.h>
 # include "structs.h"
 # include "mem.h"
 # include "macros.h"
 
+/*
+ * Capacity growth factor in percent: a full vector grows to
+ * LV_VEC_GROWTH / 100 times its capacity (200 doubles, 150 is 1.5x).
+ */
+
+# ifndef LV_VEC_GROWTH
+#  define LV_VEC_GROWTH 200
+# endif
+
+/*
+ * Ranges of at most LV_SORT_CUTOFF elements are insertion sorted.
+ */
+
+# ifndef LV_SORT_CUTOFF
+#  define LV_SORT_CUTOFF 16
+# endif
+
 t_vec		lv_vec(size_t alloc_size, size_t sizeof_type);
 void		lv_vec_push(t_vec *vec, void *data, size_t len);
 void		lv_vec_free(t_vec *vec);
@@ -38,7 +56,174 @@ void		lv_vec_insert(t_vec *v, size_t index, void *data,
 void		*lv_vec_peek_last(t_vec *__restrict__ v);
 t_u8		lv_vec_popmv(void *__restrict__ dst, t_vec *__restrict__ v);
 void		lv_vec_rev(t_vec *v);
+void		lv_vec_extend_from(t_vec *v, const t_vec *src);
+void		lv_vec_resize(t_vec *v, size_t n, const void *fill);
+void		lv_vec_map(t_vec *v, void (*f)(void *elem, void *ctx), void *ctx);
+size_t		lv_vec_filter(t_vec *v, bool (*keep)(const void *elem, void *ctx),
+				void *ctx);
+void		lv_vec_reduce(const t_vec *v, void *acc,
+				void (*f)(void *acc, const void *elem, void *ctx), void *ctx);
+void		lv_vec_sort(t_vec *v, int (*cmp)(const void *, const void *));
+bool		lv_vec_radix_sort_u32(t_vec *v);
+bool		lv_vec_radix_sort_u64(t_vec *v);
+bool		lv_vec_radix_sort_key_offset(t_vec *v, size_t offset,
+				size_t key_size);
 void		*lv_vec_get_mut(t_vec *vec, size_t idx);
 void		*lv_vec_get_clone(t_vec *vec, size_t idx);
-const void	*lv_vec_get(t_vec *vec, size_t idx);
+const void	*lv_vec_get(const t_vec *vec, size_t idx);
+bool		_lv_vec_grow(t_vec *vec, size_t len);
+
+/*
+ * Unchecked access. LV_VEC_AT(v, T, i) is element i of the t_vec pointed
+ * to by v, as an lvalue of type T; nothing checks that i < v->size.
+ * LV_VEC_FOREACH(v, T, it) runs the statement that follows once per
+ * element, with `it` a T * walking the data:
+ *
+ *     LV_VEC_FOREACH(&v, int, it)
+ *         sum += *it;
+ *
+ * Both compile to plain pointer arithmetic. `v` is evaluated more than
+ * once, and the loop must not push to or shrink the vector. Use
+ * `lv_vec_get` and friends when the index may be out of range.
+ */
+
+# define LV_VEC_AT(v, T, i)	(((T *)(v)->data)[i])
+
+# define LV_VEC_FOREACH(v, T, it)                                   \
+	for (T *it = (T *)(v)->data, *it##_end = it + (v)->size;        \
+		it < it##_end; it++)
+
+/*
+ * Typed vectors. LV_VEC_DECL(T, name) declares `t_name`, a vector of T
+ * sharing the t_vec layout (`.vec` is the plain t_vec, for the lv_vec_*
+ * functions and LV_DEFER_VEC), and inline accessors on it:
+ *
+ * name_new(n)        - a vector with room for n elements.
+ * name_push(v, x)    - appends x; false on allocation failure.
+ * name_pop(v, out)   - removes the last element, stored to out unless
+ *                      out is NULL; false if the vector is empty.
+ * name_get(v, i)     - element i, unchecked.
+ * name_at(v, i)      - pointer to element i, NULL if out of range.
+ * name_free(v)       - frees the vector.
+ * name_map(v, f)     - replaces every element x with f(x).
+ * name_filter(v, k)  - keeps the elements x where k(x) holds; returns
+ *                      the number removed.
+ * name_reduce(v, a, f) - folds the elements into a with a = f(a, x).
+ * name_sort(v, cmp)  - `lv_vec_sort` with a `qsort` comparator.
+ *
+ * The element size is a compile-time constant, so accesses compile to
+ * plain loads and stores, and loops over `v.data` can be vectorized.
+ * Only growth leaves the inline path (`_lv_vec_grow`). map, filter and
+ * reduce are always inlined: given a callback the compiler can see, the
+ * callback is inlined too and the loop vectorizes.
+ *
+ * Use at file scope, without a trailing semicolon:
+ *     LV_VEC_DECL(int, ivec)
+ *     t_ivec v = ivec_new(16);
+ */
+
+# define LV_VEC_DECL(T, name)                                       \
+	typedef union u_##name                                          \
+	{                                                               \
+		t_vec	vec;                                                \
+		struct                                                      \
+		{                                                           \
+			size_t	size;                                           \
+			T		*data;                                          \
+			size_t	alloc_size;                                     \
+			size_t	sizeof_type;                                    \
+		};                                                          \
+	}	t_##name;                                                   \
+                                                                    \
+	static inline t_##name	name##_new(size_t n)                    \
+	{                                                               \
+		return ((t_##name){.vec = lv_vec(n, sizeof(T))});           \
+	}                                                               \
+                                                                    \
+	static inline bool	name##_push(t_##name *v, T x)               \
+	{                                                               \
+		if (v->size == v->alloc_size)                               \
+		{                                                           \
+			v->sizeof_type = sizeof(T);                             \
+			if (!_lv_vec_grow(&v->vec, 1))                          \
+				return (false);                                     \
+		}                                                           \
+		v->data[v->size++] = x;                                     \
+		return (true);                                              \
+	}                                                               \
+                                                                    \
+	static inline bool	name##_pop(t_##name *v, T *out)             \
+	{                                                               \
+		if (!v->size)                                               \
+			return (false);                                         \
+		v->size--;                                                  \
+		if (out)                                                    \
+			*out = v->data[v->size];                                \
+		v->data[v->size] = (T){0};                                  \
+		return (true);                                              \
+	}                                                               \
+                                                                    \
+	static inline T	name##_get(const t_##name *v, size_t i)         \
+	{                                                               \
+		return (v->data[i]);                                        \
+	}                                                               \
+                                                                    \
+	static inline T	*name##_at(t_##name *v, size_t i)               \
+	{                                                               \
+		if (i >= v->size)                                           \
+			return (NULL);                                          \
+		return (v->data + i);                                       \
+	}                                                               \
+                                                                    \
+	static inline void	name##_free(t_##name *v)                    \
+	{                                                               \
+		lv_vec_free(&v->vec);                                       \
+	}                                                               \
+                                                                    \
+	LV_INLINE static inline void	name##_map(t_##name *v, T (*f)(T)) \
+	{                                                               \
+		size_t	i = 0;                                              \
+                                                                    \
+		while (i < v->size)                                         \
+		{                                                           \
+			v->data[i] = f(v->data[i]);                             \
+			i++;                                                    \
+		}                                                           \
+	}                                                               \
+                                                                    \
+	LV_INLINE static inline size_t	name##_filter(t_##name *v,      \
+		bool (*keep)(T))                                            \
+	{                                                               \
+		size_t	i = 0;                                              \
+		size_t	n = 0;                                              \
+                                                                    \
+		while (i < v->size)                                         \
+		{                                                           \
+			if (keep(v->data[i]))                                   \
+				v->data[n++] = v->data[i];                          \
+			i++;                                                    \
+		}                                                           \
+		i = n;                                                      \
+		while (i < v->size)                                         \
+			v->data[i++] = (T){0};                                  \
+		i = v->size - n;                                            \
+		v->size = n;                                                \
+		return (i);                                                 \
+	}                                                               \
+                                                                    \
+	LV_INLINE static inline T	name##_reduce(const t_##name *v, T acc, \
+		T (*f)(T, T))                                               \
+	{                                                               \
+		size_t	i = 0;                                              \
+                                                                    \
+		while (i < v->size)                                         \
+			acc = f(acc, v->data[i++]);                             \
+		return (acc);                                               \
+	}                                                               \
+                                                                    \
+	static inline void	name##_sort(t_##name *v,                    \
+		int (*cmp)(const void *, const void *))                     \
+	{                                                               \
+		lv_vec_sort(&v->vec, cmp);                                  \
+	}
 #endif
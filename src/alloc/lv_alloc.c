@@ -64,13 +64,16 @@ void	*lv_alloc_align(size_t size, size_t align)
 		return (NULL);
 	cc = (t_uptr)tab + sizeof(void *);
 	ac = (void *)((cc + (align - 1)) & ~(align - 1));
-	return (((void **)ac)[-1] = tab, ac);
+	((void **)ac)[-1] = tab;
+	if (LV_ALLOC_STATS)
+		_lv_stat_alloc(ac, size);
+	return (ac);
 }
 
 /*
  * Function: lv_alloc
  * ------------------
- * Allocates a memory block with 128-byte alignment.
+ * Allocates a memory block aligned to at least DEF_ALIGN.
  *
  * Parameters:
  * size - size of memory to allocate in bytes
@@ -80,7 +83,13 @@ void	*lv_alloc_align(size_t size, size_t align)
  * NULL on failure.
  *
  * Notes:
- * - Uses lv_alloc_align to ensure alignment.
+ * - Requests up to LV_SLAB_MAX bytes come from the slab allocator
+ * (`lv_slab_alloc`) when LV_ALLOC_SLAB is enabled: no header, no
+ * malloc call, and no lock on the common path.
+ * - Requests of LV_HUGE_THRESHOLD bytes or more get their own mapping
+ * with transparent huge pages (see `lv_alloc_ex`).
+ * - Everything else, or any request once the slab region is exhausted,
+ * uses lv_alloc_align.
  * - Intended for optimized use with lv_mem* operations.
  */
 
@@ -89,8 +98,47 @@ void	*lv_alloc(size_t size)
 {
 	void	*new_alloc;
 
+	if (LV_ALLOC_SLAB && size <= LV_SLAB_MAX)
+	{
+		new_alloc = lv_slab_alloc(size);
+		if (new_alloc)
+			return (new_alloc);
+	}
+	if (size >= LV_HUGE_THRESHOLD)
+		return (_lv_huge_alloc(size, 0));
 	new_alloc = lv_alloc_align(size, DEF_ALIGN);
 	if (!new_alloc)
 		return (NULL);
 	return (new_alloc);
 }
+
+/*
+ * Function: lv_alloc_ex
+ * ---------------------
+ * Allocates a memory block like `lv_alloc`, with placement flags.
+ *
+ * Parameters:
+ * size  - size of memory to allocate in bytes
+ * flags - `LV_ALLOC_HUGE` to map the block directly whatever its size,
+ * `LV_ALLOC_POPULATE` to also fault all of its pages in up front (and
+ * so map it directly too). 0 behaves like `lv_alloc`.
+ *
+ * Returns:
+ * A pointer to the allocated memory on success.
+ * NULL on failure.
+ *
+ * Notes:
+ * - Directly mapped blocks are zero-filled, start on a 2 MiB boundary
+ * (plus a LV_HUGE_HDR byte header) once they reach that size, and are
+ * advised with MADV_HUGEPAGE, which cuts TLB misses on large tables.
+ * - `lv_extend`/`lv_realloc` resize them with mremap, without copying.
+ * - Free them with `lv_free` as usual.
+ */
+
+__attribute__((malloc))
+void	*lv_alloc_ex(size_t size, int flags)
+{
+	if (flags & (LV_ALLOC_HUGE | LV_ALLOC_POPULATE))
+		return (_lv_huge_alloc(size, flags));
+	return (lv_alloc(size));
+}
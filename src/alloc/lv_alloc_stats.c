@@ -0,0 +1,436 @@
+/**
+ * lv_alloc_stats.c
+ *
+ * Copyright (C) 2025 lvzrr <lvzrr@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General
+ * Public License along with this program. If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#define _GNU_SOURCE
+#include "alloc.h"
+#include <execinfo.h>
+#include <malloc.h>
+#include <pthread.h>
+
+/*
+ * Counters are sharded per thread: each thread owns one cache-line
+ * aligned shard and updates it without atomic read-modify-write, so the
+ * hooks never contend. Shards live on a global list that is only ever
+ * pushed to; a shard is recycled by the next new thread once its owner
+ * exits, so the list stays as long as the peak thread count.
+ */
+
+static t_alloc_shard			*g_shards;
+static __thread t_alloc_shard	*g_shard;
+static pthread_key_t			g_shard_key;
+static pthread_once_t			g_shard_once = PTHREAD_ONCE_INIT;
+
+/*
+ * Process wide live bytes, fed by the shards in LV_STATS_FLUSH steps,
+ * and its high-water mark.
+ */
+
+static ssize_t					g_live;
+static size_t					g_peak;
+
+/*
+ * Sampled allocation sites: one allocation in `g_trace_period` (per
+ * thread) has its backtrace recorded in a ring of LV_TRACE_RING entries.
+ */
+
+static size_t					g_trace_period;
+static size_t					g_trace_next;
+static t_alloc_sample			g_trace[LV_TRACE_RING];
+
+/*
+ * Function: _add
+ * --------------
+ * Bumps a counter of the calling thread's shard. Only the owner writes
+ * it; the relaxed store keeps concurrent snapshots well defined.
+ */
+
+LV_INLINE static inline void	_add(size_t *counter, size_t v)
+{
+	__atomic_store_n(counter, *counter + v, __ATOMIC_RELAXED);
+}
+
+/*
+ * Function: _flush
+ * ----------------
+ * Moves a shard's pending live bytes to the global counter and raises
+ * the peak if needed.
+ */
+
+static void	_flush(t_alloc_shard *s)
+{
+	ssize_t	live;
+	size_t	peak;
+
+	if (!s->pending)
+		return ;
+	live = __atomic_add_fetch(&g_live, s->pending, __ATOMIC_RELAXED);
+	s->pending = 0;
+	peak = __atomic_load_n(&g_peak, __ATOMIC_RELAXED);
+	while (live > 0 && (size_t)live > peak
+		&& !__atomic_compare_exchange_n(&g_peak, &peak, (size_t)live, true,
+			__ATOMIC_RELAXED, __ATOMIC_RELAXED))
+		;
+}
+
+/*
+ * Function: _shard_release / _shard_key_init
+ * ------------------------------------------
+ * Thread exit hook, which flushes the thread's shard and marks it free
+ * for reuse, and its one-time key creation.
+ */
+
+static void	_shard_release(void *shard)
+{
+	t_alloc_shard	*s;
+
+	s = shard;
+	_flush(s);
+	g_shard = NULL;
+	__atomic_store_n(&s->in_use, 0, __ATOMIC_RELEASE);
+}
+
+static void	_shard_key_init(void)
+{
+	pthread_key_create(&g_shard_key, _shard_release);
+}
+
+/*
+ * Function: _shard
+ * ----------------
+ * Returns the calling thread's shard, claiming a free one or pushing a
+ * new one on first use. Returns NULL if none could be allocated.
+ *
+ * Notes:
+ * - Shards come from calloc, not `lv_alloc`, since they are allocated
+ * from inside the allocator hooks.
+ */
+
+static t_alloc_shard	*_shard(void)
+{
+	t_alloc_shard	*s;
+	int				free_;
+
+	if (g_shard)
+		return (g_shard);
+	pthread_once(&g_shard_once, _shard_key_init);
+	s = __atomic_load_n(&g_shards, __ATOMIC_ACQUIRE);
+	while (s)
+	{
+		free_ = 0;
+		if (__atomic_compare_exchange_n(&s->in_use, &free_, 1, false,
+				__ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+			break ;
+		s = s->next;
+	}
+	if (!s)
+	{
+		s = calloc(1, sizeof(t_alloc_shard));
+		if (!s)
+			return (NULL);
+		s->in_use = 1;
+		s->next = __atomic_load_n(&g_shards, __ATOMIC_RELAXED);
+		while (!__atomic_compare_exchange_n(&g_shards, &s->next, s, true,
+				__ATOMIC_RELEASE, __ATOMIC_RELAXED))
+			;
+	}
+	pthread_setspecific(g_shard_key, s);
+	return (g_shard = s);
+}
+
+/*
+ * Function: _live
+ * ---------------
+ * Accounts `delta` live bytes to a shard, flushing once the pending
+ * amount reaches LV_STATS_FLUSH either way.
+ */
+
+LV_INLINE static inline void	_live(t_alloc_shard *s, ssize_t delta)
+{
+	s->pending += delta;
+	if (s->pending >= LV_STATS_FLUSH || s->pending <= -LV_STATS_FLUSH)
+		_flush(s);
+}
+
+/*
+ * Function: _sample
+ * -----------------
+ * Records the call stack of the current allocation in the trace ring.
+ */
+
+static void	_sample(size_t size)
+{
+	t_alloc_sample	*slot;
+
+	slot = &g_trace[__atomic_fetch_add(&g_trace_next, 1, __ATOMIC_RELAXED)
+		% LV_TRACE_RING];
+	slot->size = size;
+	slot->depth = backtrace(slot->frames, LV_TRACE_DEPTH);
+}
+
+/*
+ * Function: _lv_stat_block
+ * ------------------------
+ * Returns the footprint of an allocator block, as accounted in the live
+ * byte count: the class size of a slab block, the mapping length of a
+ * huge block, the usable size of the malloc chunk otherwise.
+ */
+
+size_t	_lv_stat_block(const void *ptr)
+{
+	t_u8	*raw;
+
+	if (lv_slab_owns(ptr))
+		return (lv_slab_size(ptr));
+	raw = ((void *const *)ptr)[-1];
+	if (_lv_huge_owns(ptr))
+		return (*(size_t *)((t_uptr)raw & ~(t_uptr)1));
+	return (malloc_usable_size(raw));
+}
+
+/*
+ * Function: _lv_stat_alloc / _lv_stat_free
+ * ----------------------------------------
+ * Allocator hooks, called by the slab, malloc and huge back ends when a
+ * block is handed out (for a request of `size` bytes) or given back.
+ */
+
+void	_lv_stat_alloc(const void *ptr, size_t size)
+{
+	t_alloc_shard	*s;
+	size_t			bs;
+	size_t			period;
+	int				c;
+
+	s = _shard();
+	if (!s)
+		return ;
+	bs = _lv_stat_block(ptr);
+	c = 0;
+	if (size > 1)
+		c = 64 - __builtin_clzll((unsigned long long)(size - 1));
+	if (c >= LV_STATS_CLASSES)
+		c = LV_STATS_CLASSES - 1;
+	_add(&s->allocs, 1);
+	_add(&s->by_class[c], 1);
+	_add(&s->bytes_alloc, bs);
+	_live(s, (ssize_t)bs);
+	period = __atomic_load_n(&g_trace_period, __ATOMIC_RELAXED);
+	if (period && (!s->countdown || !--s->countdown))
+	{
+		s->countdown = period;
+		_sample(size);
+	}
+}
+
+void	_lv_stat_free(const void *ptr)
+{
+	t_alloc_shard	*s;
+	size_t			bs;
+
+	s = _shard();
+	if (!s)
+		return ;
+	bs = _lv_stat_block(ptr);
+	_add(&s->frees, 1);
+	_add(&s->bytes_freed, bs);
+	_live(s, -(ssize_t)bs);
+}
+
+/*
+ * Function: _lv_stat_resize
+ * -------------------------
+ * Hook of `_lv_regrow`: a block went from `old` to `size` footprint
+ * bytes, in place or, if `moved`, by copying `copied` bytes. Blocks that
+ * moved through `lv_alloc`/`lv_free` pass 0 for both sizes, since those
+ * calls already accounted them.
+ */
+
+void	_lv_stat_resize(size_t old, size_t size, bool moved, size_t copied)
+{
+	t_alloc_shard	*s;
+
+	s = _shard();
+	if (!s)
+		return ;
+	_add(&s->bytes_alloc, size);
+	_add(&s->bytes_freed, old);
+	_live(s, (ssize_t)size - (ssize_t)old);
+	if (!moved)
+	{
+		_add(&s->extend_inplace, 1);
+		return ;
+	}
+	_add(&s->extend_copies, 1);
+	_add(&s->bytes_copied, copied);
+}
+
+/*
+ * Function: _lv_stat_chunk
+ * ------------------------
+ * Arena hook: `delta` is 1 when a chunk is allocated from the system,
+ * -1 when one is given back.
+ */
+
+void	_lv_stat_chunk(int delta)
+{
+	t_alloc_shard	*s;
+
+	s = _shard();
+	if (!s)
+		return ;
+	if (delta > 0)
+		_add(&s->chunks_new, 1);
+	else
+		_add(&s->chunks_freed, 1);
+}
+
+/*
+ * Function: lv_alloc_stats
+ * ------------------------
+ * Takes a snapshot of the allocation statistics.
+ *
+ * Parameters:
+ * None.
+ *
+ * Returns:
+ * The counters summed over every thread since the start of the process:
+ * - `live`/`peak`: bytes held in allocator blocks, now and at most.
+ * - `allocs`/`frees` and `by_class`: block counts, the latter bucketed
+ * by power of two request size.
+ * - `extend_inplace`, `extend_copies`, `bytes_copied`: outcome of the
+ * resizes done by `lv_extend`, `lv_realloc` and friends.
+ * - `arena_chunks`: arena chunks currently allocated, cached ones
+ * included.
+ * All zero, with `enabled` 0, unless built with LV_ALLOC_STATS=1.
+ *
+ * Notes:
+ * - Byte counts are block footprints (slab class, mapping length or
+ * malloc usable size), not requested sizes.
+ * - Blocks of `lv_slab_alloc`, `lv_alloc_align` and `lv_alloc_ex` are
+ * counted too, arena allocations only through their chunks.
+ * - Each thread flushes its live count every LV_STATS_FLUSH bytes, so
+ * `peak` can lag the true high-water mark by that much per thread.
+ * - Counters are read without stopping other threads: a snapshot taken
+ * while they allocate is consistent per counter, not across counters.
+ */
+
+t_alloc_stats	lv_alloc_stats(void)
+{
+	t_alloc_stats	st;
+	t_alloc_shard	*s;
+	size_t			in;
+	size_t			out;
+	int				c;
+
+	lv_memset(&st, 0, sizeof(st));
+	if (!LV_ALLOC_STATS)
+		return (st);
+	st.enabled = 1;
+	in = 0;
+	out = 0;
+	s = __atomic_load_n(&g_shards, __ATOMIC_ACQUIRE);
+	while (s)
+	{
+		in += __atomic_load_n(&s->bytes_alloc, __ATOMIC_RELAXED);
+		out += __atomic_load_n(&s->bytes_freed, __ATOMIC_RELAXED);
+		st.allocs += __atomic_load_n(&s->allocs, __ATOMIC_RELAXED);
+		st.frees += __atomic_load_n(&s->frees, __ATOMIC_RELAXED);
+		c = -1;
+		while (++c < LV_STATS_CLASSES)
+			st.by_class[c] += __atomic_load_n(&s->by_class[c],
+					__ATOMIC_RELAXED);
+		st.extend_inplace += __atomic_load_n(&s->extend_inplace,
+				__ATOMIC_RELAXED);
+		st.extend_copies += __atomic_load_n(&s->extend_copies,
+				__ATOMIC_RELAXED);
+		st.bytes_copied += __atomic_load_n(&s->bytes_copied,
+				__ATOMIC_RELAXED);
+		st.arena_chunks += __atomic_load_n(&s->chunks_new, __ATOMIC_RELAXED)
+			- __atomic_load_n(&s->chunks_freed, __ATOMIC_RELAXED);
+		s = s->next;
+	}
+	st.live = in - out;
+	st.peak = LV_MAX(__atomic_load_n(&g_peak, __ATOMIC_RELAXED), st.live);
+	return (st);
+}
+
+/*
+ * Function: lv_alloc_trace
+ * ------------------------
+ * Turns the allocation-site sampler on or off.
+ *
+ * Parameters:
+ * period - Record the call stack of one allocation in `period`, per
+ * thread (1 records them all). 0 turns sampling off.
+ *
+ * Returns:
+ * None.
+ *
+ * Notes:
+ * - Only effective when built with LV_ALLOC_STATS=1.
+ * - Each sample costs a `backtrace` call; keep the period large (a few
+ * thousand) to profile growth patterns in production runs.
+ */
+
+void	lv_alloc_trace(size_t period)
+{
+	__atomic_store_n(&g_trace_period, period, __ATOMIC_RELAXED);
+}
+
+/*
+ * Function: lv_alloc_samples
+ * --------------------------
+ * Copies out the most recent allocation samples.
+ *
+ * Parameters:
+ * out - Destination array.
+ * max - Its capacity, in samples.
+ *
+ * Returns:
+ * The number of samples written, oldest first. At most LV_TRACE_RING
+ * are kept.
+ *
+ * Notes:
+ * - Frames are return addresses, innermost first, as given by
+ * `backtrace`; resolve them with `backtrace_symbols` or addr2line.
+ * - Call it while no thread is being sampled: a slot being rewritten
+ * concurrently can be read half updated.
+ */
+
+size_t	lv_alloc_samples(t_alloc_sample *out, size_t max)
+{
+	size_t	next;
+	size_t	n;
+	size_t	i;
+
+	next = __atomic_load_n(&g_trace_next, __ATOMIC_ACQUIRE);
+	n = next;
+	if (n > LV_TRACE_RING)
+		n = LV_TRACE_RING;
+	if (n > max)
+		n = max;
+	i = 0;
+	while (i < n)
+	{
+		out[i] = g_trace[(next - n + i) % LV_TRACE_RING];
+		i++;
+	}
+	return (n);
+}
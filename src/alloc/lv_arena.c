@@ -19,86 +19,517 @@
  */
 
 #include "alloc.h"
+#include <pthread.h>
 
 /*
- * Function: lv_init_arena
- * -----------------------
- * Initializes a new memory arena. An arena consists of a 't_arena' structure
- * and a large memory 'pool' from which smaller allocations can be made.
+ * Recycled chunks, one row of slots per size class (DEFAULT_ARENA_SIZE
+ * << class). Each slot is either NULL or owns one chunk; a chunk changes
+ * hands with a single compare-and-swap or exchange on its slot, so the
+ * cache is lock-free and has no ABA problem (nothing ever reads a chunk
+ * it does not own).
+ */
+
+static t_arena			*g_cache[LV_ARENA_CLASSES][LV_ARENA_CACHE];
+
+/*
+ * The calling thread's implicit arena, used by `lv_arena`. The key's
+ * destructor hands its chunks back to the cache when the thread exits.
+ */
+
+static __thread t_arena	*g_tls_arena;
+static pthread_key_t	g_tls_key;
+static pthread_once_t	g_tls_once = PTHREAD_ONCE_INIT;
+static int				g_tls_keyed;
+
+/*
+ * Function: _chunk_class
+ * ----------------------
+ * Returns the cache class of a pool size, or -1 if chunks of that size
+ * are not cached (oversized requests, or a cap that is not a power of
+ * two multiple of DEFAULT_ARENA_SIZE).
+ */
+
+static int	_chunk_class(size_t size)
+{
+	int	c;
+
+	c = 0;
+	while (c < LV_ARENA_CLASSES)
+	{
+		if ((DEFAULT_ARENA_SIZE << c) == size)
+			return (c);
+		if ((DEFAULT_ARENA_SIZE << c) > size)
+			break ;
+		c++;
+	}
+	return (-1);
+}
+
+/*
+ * Function: _cache_push
+ * ---------------------
+ * Parks a chunk in the first free slot of its class. Returns false if
+ * the row is full, in which case the caller still owns the chunk.
+ */
+
+static bool	_cache_push(int c, t_arena *chunk)
+{
+	t_arena	*expected;
+	size_t	i;
+
+	i = 0;
+	while (i < LV_ARENA_CACHE)
+	{
+		expected = NULL;
+		if (!__atomic_load_n(&g_cache[c][i], __ATOMIC_RELAXED)
+			&& __atomic_compare_exchange_n(&g_cache[c][i], &expected, chunk,
+				false, __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+			return (true);
+		i++;
+	}
+	return (false);
+}
+
+/*
+ * Function: _cache_pop
+ * --------------------
+ * Takes ownership of any cached chunk of class `c`, or returns NULL if
+ * there is none.
+ */
+
+static t_arena	*_cache_pop(int c)
+{
+	t_arena	*chunk;
+	size_t	i;
+
+	i = 0;
+	while (i < LV_ARENA_CACHE)
+	{
+		if (__atomic_load_n(&g_cache[c][i], __ATOMIC_RELAXED))
+		{
+			chunk = __atomic_exchange_n(&g_cache[c][i], NULL,
+					__ATOMIC_ACQUIRE);
+			if (chunk)
+				return (chunk);
+		}
+		i++;
+	}
+	return (NULL);
+}
+
+/*
+ * Function: _chunk_size
+ * ---------------------
+ * Picks the pool size of a new chunk: twice the previous chunk, starting
+ * at DEFAULT_ARENA_SIZE and capped at LV_ARENA_MAX_CHUNK, or more if a
+ * single request needs it.
+ */
+
+static size_t	_chunk_size(size_t need, size_t prev)
+{
+	size_t	total;
+
+	total = DEFAULT_ARENA_SIZE;
+	while (total < LV_ARENA_MAX_CHUNK && (total < need || total <= prev))
+		total <<= 1;
+	if (total > LV_ARENA_MAX_CHUNK && LV_ARENA_MAX_CHUNK >= DEFAULT_ARENA_SIZE)
+		total = LV_ARENA_MAX_CHUNK;
+	if (total < need)
+		total = (need + 4095) & ~(size_t)4095;
+	return (total);
+}
+
+/*
+ * Function: _chunk_new
+ * --------------------
+ * Gets an empty chunk able to serve `need` bytes. The chunk header and
+ * its pool are a single allocation, with the pool right after the
+ * header and aligned to LV_ARENA_ALIGN.
  *
  * Parameters:
- * size - The initial requested allocation size. The pool will be at least
- * twice this size or a default minimum (DEFAULT_ARENA_SIZE), whichever is larger.
+ * need - The number of bytes the chunk must hold.
+ * prev - The pool size of the arena's current chunk, 0 for a new arena.
  *
  * Returns:
- * A pointer to the newly created 't_arena' structure on success.
- * NULL if memory allocation fails for either the arena structure or its pool.
+ * An empty chunk, or NULL on overflow or allocation failure.
+ *
+ * Notes:
+ * - Chunks of a cached class are taken from the global cache when it
+ * has one, so a thread that creates and destroys arenas in a loop does
+ * not go back to `malloc`.
  */
 
-static t_arena	*lv_init_arena(size_t size)
+static t_arena	*_chunk_new(size_t need, size_t prev)
 {
-	size_t total_size;
+	t_arena	*chunk;
+	size_t	total;
+	int		c;
 
-	t_arena *arena = lv_alloc(sizeof(t_arena));
-	if (!arena)
+	if (need > SIZE_MAX - sizeof(t_arena) - LV_ARENA_ALIGN - 4096)
 		return (NULL);
-	total_size = LV_MAX(size * 2, DEFAULT_ARENA_SIZE);
-	arena->pool = lv_alloc(total_size);
-	if (!arena->pool)
-		return (lv_free(&(arena->pool)), NULL);
-	arena->size = total_size;
-	arena->offset = 0;
-	arena->next = NULL;
-	return (arena);
+	total = _chunk_size(need, prev);
+	chunk = NULL;
+	c = _chunk_class(total);
+	if (c >= 0)
+		chunk = _cache_pop(c);
+	if (!chunk)
+	{
+		chunk = lv_alloc_align(sizeof(t_arena) + total, LV_ARENA_ALIGN);
+		if (!chunk)
+			return (NULL);
+		if (LV_ALLOC_STATS)
+			_lv_stat_chunk(1);
+		chunk->size = total;
+		chunk->pool = chunk + 1;
+	}
+	chunk->offset = 0;
+	chunk->next = NULL;
+	chunk->current = chunk;
+	return (chunk);
 }
 
 /*
- * Function: lv_manage_req
- * -----------------------
- * Manages allocation requests within a given memory arena. This function handles
- * memory alignment and determines if the current arena has enough space.
- * If not, it attempts to create a new arena and recursively allocates from it.
+ * Function: _chunk_release
+ * ------------------------
+ * Returns a chunk to the global cache, or frees it if its size is not
+ * cached or its row is full.
+ */
+
+static void	_chunk_release(t_arena *chunk)
+{
+	void	*t;
+	int		c;
+
+	c = _chunk_class(chunk->size);
+	if (c >= 0 && _cache_push(c, chunk))
+		return ;
+	if (LV_ALLOC_STATS)
+		_lv_stat_chunk(-1);
+	t = chunk;
+	lv_free(&t);
+}
+
+/*
+ * Function: _tls_destroy / _tls_key_init
+ * --------------------------------------
+ * Thread exit hook for the implicit per-thread arena, and its one-time
+ * key creation.
+ */
+
+static void	_tls_destroy(void *arena)
+{
+	lv_arena_destroy((t_arena *)arena);
+	g_tls_arena = NULL;
+}
+
+static void	_tls_key_init(void)
+{
+	g_tls_keyed = !pthread_key_create(&g_tls_key, _tls_destroy);
+}
+
+/*
+ * Function: _implicit_arena
+ * -------------------------
+ * Returns the calling thread's implicit arena, creating it (sized for
+ * `size`) and arming its cleanup on first use.
+ */
+
+static t_arena	*_implicit_arena(size_t size)
+{
+	if (g_tls_arena)
+		return (g_tls_arena);
+	g_tls_arena = lv_arena_create(size);
+	if (!g_tls_arena)
+		return (NULL);
+	pthread_once(&g_tls_once, _tls_key_init);
+	if (g_tls_keyed)
+		pthread_setspecific(g_tls_key, g_tls_arena);
+	lv_free_arena(g_tls_arena);
+	return (g_tls_arena);
+}
+
+/*
+ * Function: lv_arena_create
+ * -------------------------
+ * Creates an arena owned by the caller.
  *
  * Parameters:
- * arena - A pointer to the current 't_arena' to allocate from.
+ * size - A hint of the size of the first allocations; the first chunk
+ * can hold at least this many bytes.
+ *
+ * Returns:
+ * The arena handle, or NULL if allocation fails.
+ *
+ * Notes:
+ * - An arena is not locked: use one per thread (or lock around it).
+ * Chunks are recycled through a lock-free global cache, so creating and
+ * destroying arenas from many threads does not contend.
+ * - The handle is the arena's first chunk. Chunks added later follow it
+ * in `next`, and `current` points at the one allocations come from;
+ * chunks past `current` are kept for reuse after a reset or rewind.
+ * - The first chunk is DEFAULT_ARENA_SIZE bytes (unless `size` needs
+ * more) and every new one doubles the previous, up to
+ * LV_ARENA_MAX_CHUNK, so small arenas stay small and large ones only
+ * take a logarithmic number of chunks.
+ */
+
+t_arena	*lv_arena_create(size_t size)
+{
+	return (_chunk_new(size, 0));
+}
+
+/*
+ * Function: _chunk_advance
+ * ------------------------
+ * Moves an arena whose current chunk is full on to the next one. A
+ * retained chunk is reused when it can hold `need` bytes; otherwise a
+ * new chunk is linked in right after the current one.
+ */
+
+static t_arena	*_chunk_advance(t_arena *arena, size_t need)
+{
+	t_arena	*cur;
+	t_arena	*chunk;
+
+	cur = arena->current;
+	if (cur->next && cur->next->size >= need)
+	{
+		chunk = cur->next;
+		chunk->offset = 0;
+	}
+	else
+	{
+		chunk = _chunk_new(need, cur->size);
+		if (!chunk)
+			return (NULL);
+		chunk->next = cur->next;
+		cur->next = chunk;
+	}
+	arena->current = chunk;
+	return (chunk);
+}
+
+/*
+ * Function: lv_arena_alloc_aligned
+ * --------------------------------
+ * Allocates `size` bytes from an arena at a chosen alignment.
+ *
+ * Parameters:
+ * arena - An arena created by `lv_arena_create`.
  * size  - The size of the memory block to allocate in bytes.
+ * align - The alignment of the block, a power of two (1 packs blocks
+ * back to back, 64 gives each its own cache line).
  *
  * Returns:
- * A pointer to the aligned allocated memory block on success.
- * NULL if allocation fails (e.g., if a new arena cannot be created).
+ * A pointer aligned to `align` on success.
+ * NULL if `arena` is NULL, `size` is 0, `align` is not a power of two,
+ * or a new chunk cannot be allocated.
  *
  * Notes:
- * - Includes space for an internal pointer (sizeof(void*)) at the start of each block.
- * - Ensures allocated memory is aligned to DEF_ALIGN.
+ * - The common case is a pointer bump in the current chunk, and blocks
+ * carry no header: the only overhead is the padding up to `align`.
+ * - When the chunk is full, the arena moves on to the next one; the
+ * space left in the old one is not revisited until the arena is reset
+ * or rewound.
+ * - Blocks are not freed individually: `lv_arena_rewind`,
+ * `lv_arena_reset` or `lv_arena_destroy` release them all at once.
  */
 
-static void	*lv_manage_req(t_arena *arena, size_t size)
+void	*lv_arena_alloc_aligned(t_arena *arena, size_t size, size_t align)
 {
-	void	*base;
-	void	*aligned;
-	size_t	padding;
+	t_arena	*cur;
+	t_uptr	base;
+	t_uptr	p;
+	size_t	need;
 
-	base = (t_u8 *)arena->pool + arena->offset + sizeof(void *);
-	aligned = (void *)(((t_uptr)base + (DEF_ALIGN - 1)) & ~(DEF_ALIGN - 1));
-	padding = (t_u8 *)aligned - (t_u8 *)base;
-	if (arena->offset + padding + size > arena->size)
+	if (!arena || !size || !align || (align & (align - 1)))
+		return (NULL);
+	cur = arena->current;
+	base = (t_uptr)cur->pool;
+	p = (base + cur->offset + (align - 1)) & ~(t_uptr)(align - 1);
+	if (p - base > cur->size || size > cur->size - (p - base))
 	{
-		if (!arena->next)
-			arena->next = lv_init_arena(size);
-		if (!arena->next)
+		if (size > SIZE_MAX - align)
+			return (NULL);
+		need = size;
+		if (align > LV_ARENA_ALIGN)
+			need += align - LV_ARENA_ALIGN;
+		cur = _chunk_advance(arena, need);
+		if (!cur)
 			return (NULL);
-		return (lv_manage_req(arena->next, size));
+		base = (t_uptr)cur->pool;
+		p = (base + (align - 1)) & ~(t_uptr)(align - 1);
 	}
-	arena->offset += padding + size;
-	return (aligned);
+	cur->offset = p - base + size;
+	return ((void *)p);
+}
+
+/*
+ * Function: lv_arena_alloc
+ * ------------------------
+ * Allocates `size` bytes from an arena, aligned to DEF_ALIGN.
+ *
+ * Parameters:
+ * arena - An arena created by `lv_arena_create`.
+ * size  - The size of the memory block to allocate in bytes.
+ *
+ * Returns:
+ * A pointer aligned to DEF_ALIGN on success.
+ * NULL if `arena` is NULL, `size` is 0, or a new chunk cannot be
+ * allocated.
+ *
+ * Notes:
+ * - Same as `lv_arena_alloc_aligned(arena, size, DEF_ALIGN)`.
+ */
+
+void	*lv_arena_alloc(t_arena *arena, size_t size)
+{
+	return (lv_arena_alloc_aligned(arena, size, DEF_ALIGN));
+}
+
+/*
+ * Function: lv_arena_mark
+ * -----------------------
+ * Takes a savepoint of an arena's current position.
+ *
+ * Parameters:
+ * arena - The arena, or NULL for the calling thread's implicit arena
+ * (the one `lv_arena` allocates from), which is created if needed.
+ *
+ * Returns:
+ * The savepoint. Its `arena` is NULL if the implicit arena could not be
+ * created, which makes rewinding to it a no-op.
+ *
+ * Notes:
+ * - Savepoints nest like a stack: rewinding to one invalidates every
+ * savepoint taken after it.
+ */
+
+t_arena_mark	lv_arena_mark(t_arena *arena)
+{
+	t_arena_mark	mark;
+
+	if (!arena)
+		arena = _implicit_arena(0);
+	mark.arena = arena;
+	mark.chunk = arena ? arena->current : NULL;
+	mark.offset = arena ? arena->current->offset : 0;
+	return (mark);
+}
+
+/*
+ * Function: lv_arena_rewind
+ * -------------------------
+ * Releases everything allocated from an arena since a savepoint was
+ * taken.
+ *
+ * Parameters:
+ * mark - A savepoint returned by `lv_arena_mark`.
+ *
+ * Returns:
+ * None.
+ *
+ * Notes:
+ * - Constant time: only the arena's position moves. Chunks added since
+ * the savepoint stay linked and are reused by the next allocations, so
+ * a loop that rewinds after each request stops allocating once it has
+ * reached its peak.
+ */
+
+void	lv_arena_rewind(t_arena_mark mark)
+{
+	if (!mark.arena || !mark.chunk)
+		return ;
+	mark.arena->current = mark.chunk;
+	mark.chunk->offset = mark.offset;
+}
+
+/*
+ * Function: lv_arena_scope_end
+ * ----------------------------
+ * Cleanup function used with the LV_ARENA_SCOPE attribute.
+ *
+ * Parameters:
+ * mark - A pointer to the savepoint variable going out of scope.
+ *
+ * Returns:
+ * None.
+ *
+ * Notes:
+ * - `LV_ARENA_SCOPE t_arena_mark m = lv_arena_mark(a);` rewinds `a`
+ * to `m` on every exit from the enclosing block.
+ */
+
+void	lv_arena_scope_end(t_arena_mark *mark)
+{
+	if (mark)
+		lv_arena_rewind(*mark);
+}
+
+/*
+ * Function: lv_arena_reset
+ * ------------------------
+ * Releases every allocation made from an arena, keeping the arena and
+ * its chunks for reuse.
+ *
+ * Parameters:
+ * arena - The arena to reset, or NULL for the calling thread's implicit
+ * arena (a no-op if it does not exist yet).
+ *
+ * Returns:
+ * None.
+ *
+ * Notes:
+ * - No chunk is freed: a request loop that resets its arena keeps a
+ * flat footprint, sized by its largest request.
+ */
+
+void	lv_arena_reset(t_arena *arena)
+{
+	if (!arena)
+		arena = g_tls_arena;
+	if (!arena)
+		return ;
+	arena->current = arena;
+	arena->offset = 0;
+}
+
+/*
+ * Function: lv_arena_destroy
+ * --------------------------
+ * Releases an arena and all of its chunks.
+ *
+ * Parameters:
+ * arena - The arena to destroy. NULL is ignored.
+ *
+ * Returns:
+ * None.
+ *
+ * Notes:
+ * - Default sized chunks go back to the global cache, the others to
+ * the system.
+ */
+
+void	lv_arena_destroy(t_arena *arena)
+{
+	t_arena	*chunk;
+
+	if (!arena)
+		return ;
+	while (arena->next)
+	{
+		chunk = arena->next;
+		arena->next = chunk->next;
+		_chunk_release(chunk);
+	}
+	_chunk_release(arena);
 }
 
 /*
  * Function: lv_arena
  * ------------------
- * The primary interface for allocating memory using the arena allocator.
- * It manages the global arena chain, initializing it on the first call
- * and then directing allocation requests to the current active arena.
+ * Allocates from the calling thread's implicit arena, creating it on
+ * the first call.
  *
  * Parameters:
  * size - The size of the memory block to allocate in bytes.
@@ -108,75 +539,77 @@ static void	*lv_manage_req(t_arena *arena, size_t size)
  * NULL if the requested size is 0 or if allocation fails.
  *
  * Notes:
- * - Uses static variables 'arena' and 'current' to maintain the state
- * of the arena chain across function calls.
- * - Registers a cleanup function (lv_free_arena) with atexit on first call.
+ * - Each thread gets its own arena (thread-local head), so there is no
+ * locking and no contention between threads.
+ * - A thread's arena is released when the thread exits. The first call
+ * also arms `lv_free_arena` with atexit for the thread calling `exit`.
+ * - `lv_arena_mark(NULL)`/`lv_arena_rewind` and `lv_arena_reset(NULL)`
+ * release memory of this arena without waiting for exit.
  */
 
 void	*lv_arena(size_t size)
 {
-	static t_arena	*arena;
-	static t_arena	*current;
-
 	if (!size)
 		return (NULL);
-	if (!arena)
-	{
-		arena = lv_init_arena(size);
-		lv_free_arena(arena);
-		current = arena;
-	}
-	if (!arena)
-		return (NULL);
-	while (current->next)
-		current = current->next;
-	return (lv_manage_req(current, size));
+	return (lv_arena_alloc(_implicit_arena(size), size));
+}
+
+/*
+ * Function: _free_arena_atexit
+ * ----------------------------
+ * The atexit hook registered by `lv_free_arena`.
+ */
+
+static void	_free_arena_atexit(void)
+{
+	lv_free_arena(NULL);
 }
 
 /*
  * Function: lv_free_arena
  * -----------------------
- * Cleans up all memory allocated by the arena allocator. This function is
+ * Cleans up the memory held by the implicit arenas. This function is
  * designed to be called automatically at program exit via atexit.
  *
  * Parameters:
- * arena - A pointer to the head of the arena chain (used only on the initial
- * call for setup; will be NULL when called by atexit).
+ * arena - Non-NULL on the setup call made by `lv_arena`, which only
+ * registers the atexit hook (once per process). NULL to run the cleanup.
  *
  * Notes:
- * - Uses a static 'store' variable to keep track of the head of the arena chain.
- * - Iterates through all linked arenas, freeing their memory pools and then
- * the arena structures themselves using 'lv_free'.
- * - Uses a temporary 'void *t' to comply with lv_free's 'void **' signature
- * and avoid strict-aliasing warnings, while also nullifying the original
- * pointers.
+ * - The cleanup destroys the calling thread's implicit arena and then
+ * frees every chunk parked in the global cache.
+ * - Arenas of threads still running at exit are left to the system.
  */
 
-void    lv_free_arena(t_arena *arena)
+void	lv_free_arena(t_arena *arena)
 {
-	static t_arena	*store;
-	t_arena			*current_arena;
-	t_arena			*next_arena;
-	void			*t;
+	static int	armed;
+	t_arena		*chunk;
+	void		*t;
+	size_t		i;
 
-	if (arena && !store)
+	if (arena)
 	{
-		store = arena;
-		atexit((void (*)(void))lv_free_arena);
-		return;
-	}
-	if (!store)
+		if (!__atomic_exchange_n(&armed, 1, __ATOMIC_ACQ_REL))
+			atexit(_free_arena_atexit);
 		return ;
-	current_arena = store;
-	while (current_arena)
+	}
+	if (g_tls_arena)
+	{
+		if (g_tls_keyed)
+			pthread_setspecific(g_tls_key, NULL);
+		lv_arena_destroy(g_tls_arena);
+		g_tls_arena = NULL;
+	}
+	i = 0;
+	while (i < LV_ARENA_CLASSES * LV_ARENA_CACHE)
 	{
-		next_arena = current_arena->next;
-		t = current_arena->pool;
-		if (current_arena->pool)
-			lv_free(&t);
-		t = current_arena;
+		chunk = __atomic_exchange_n(&g_cache[i / LV_ARENA_CACHE]
+			[i % LV_ARENA_CACHE], NULL, __ATOMIC_ACQUIRE);
+		if (LV_ALLOC_STATS && chunk)
+			_lv_stat_chunk(-1);
+		t = chunk;
 		lv_free(&t);
-		current_arena = next_arena;
+		i++;
 	}
-	store = NULL;
 }
@@ -20,6 +20,32 @@
 
 #include "alloc.h"
 
+/*
+ * Function: _calloc_align
+ * -----------------------
+ * `lv_alloc_align(size, DEF_ALIGN)` on top of calloc, which knows when
+ * its chunk comes straight from the kernel (or from never used heap)
+ * and only clears recycled memory.
+ */
+
+static void	*_calloc_align(size_t size)
+{
+	void	*raw;
+	void	*p;
+
+	if (size > SIZE_MAX - sizeof(void *) - (DEF_ALIGN - 1))
+		return (NULL);
+	raw = calloc(1, sizeof(void *) + (DEF_ALIGN - 1) + size);
+	if (!raw)
+		return (NULL);
+	p = (void *)(((t_uptr)raw + sizeof(void *) + (DEF_ALIGN - 1))
+			& ~(t_uptr)(DEF_ALIGN - 1));
+	((void **)p)[-1] = raw;
+	if (LV_ALLOC_STATS)
+		_lv_stat_alloc(p, size);
+	return (p);
+}
+
 /*
  * Function: lv_calloc
  * -------------------
@@ -35,6 +61,10 @@
  *
  * Notes:
  *   - Equivalent to calloc(n, size), but aligned.
+ *   - Only recycled memory is cleared. Huge blocks are fresh mappings,
+ *   zero-filled by the kernel, and malloc backed blocks come from
+ *   calloc, which skips clearing fresh chunks; in both cases pages are
+ *   not touched until first written. Slab blocks are cleared.
  */
 
 void	*lv_calloc(size_t n, size_t size)
@@ -45,9 +75,13 @@ void	*lv_calloc(size_t n, size_t size)
 	total = n * size;
 	if (size != 0 && n > SIZE_MAX / size)
 		return (0);
-	alloc = lv_alloc(total);
-	if (!alloc)
-		return (NULL);
-	lv_memset(alloc, 0, total);
-	return (alloc);
+	if (LV_ALLOC_SLAB && total <= LV_SLAB_MAX)
+	{
+		alloc = lv_slab_alloc(total);
+		if (alloc)
+			return (lv_memset(alloc, 0, total));
+	}
+	if (total >= LV_HUGE_THRESHOLD)
+		return (_lv_huge_alloc(total, 0));
+	return (_calloc_align(total));
 }
@@ -23,8 +23,7 @@
 /*
  * Function: lv_extend
  * -------------------
- * Extends a memory block by allocating a new block of n + size bytes,
- * copying the original data, and freeing the old block.
+ * Extends a memory block to n + size bytes, keeping its first n bytes.
  *
  * Parameters:
  *   ptr  - original memory block (can be NULL)
@@ -35,22 +34,18 @@
  *   Pointer to the new extended memory block, or NULL on failure.
  *
  * Notes:
- *   - Always frees the original pointer.
- *   - Returns NULL if size is zero and ptr is non-NULL.
+ *   - Grows the block in place when it can (see `_lv_regrow`); the
+ *   original pointer is invalid afterwards unless NULL is returned.
+ *   - Returns NULL if size is zero and ptr is non-NULL (ptr is freed).
+ *   - On allocation failure ptr is left untouched.
  *   - Memory is not zero-initialized.
  */
 
 void	*lv_extend(void *ptr, size_t n, size_t size)
 {
-	unsigned char	*p2;
-
 	if (size > SIZE_MAX - n || (size == 0 && ptr))
 		return (lv_free(&ptr), NULL);
 	if (!ptr)
 		return (lv_alloc(n + size));
-	p2 = lv_alloc(n + size);
-	if (!p2)
-		return (NULL);
-	lv_memmove(p2, ptr, n);
-	return (lv_free(&ptr), p2);
+	return (_lv_regrow(ptr, n, n + size, false));
 }
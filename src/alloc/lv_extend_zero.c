@@ -34,21 +34,19 @@
  *   Pointer to the new extended memory block, or NULL on failure.
  *
  * Notes:
- *   - Always frees the original pointer.
- *   - New memory is zero-initialized.
+ *   - Grows the block in place when it can (see `_lv_regrow`); the
+ *   original pointer is invalid afterwards unless NULL is returned.
+ *   - Only the `size` new bytes are zeroed; the first `n` are kept as
+ *   they are instead of being cleared and copied over.
+ *   - New bytes the kernel already zero-filled (growth of a huge block,
+ *   or a move into one) are not written, so their pages stay unfaulted.
  */
 
 void	*lv_extend_zero(void *ptr, size_t n, size_t size)
 {
-	unsigned char	*p2;
-
 	if (size > SIZE_MAX - n || (size == 0 && ptr))
 		return (lv_free(&ptr), NULL);
 	if (!ptr)
 		return (lv_calloc(n + size, 1));
-	p2 = lv_calloc(n + size, 1);
-	if (!p2)
-		return (NULL);
-	lv_memmove(p2, ptr, n);
-	return (lv_free(&ptr), p2);
+	return (_lv_regrow(ptr, n, n + size, true));
 }
@@ -37,8 +37,11 @@
  * Notes:
  * - Safe to call on `NULL` or already-freed pointers (if the pointer
  * has been correctly set to `NULL` by a previous call).
- * - It retrieves the original `malloc`'d address, which was stored
- * just before the aligned pointer, and then calls the underlying `free`.
+ * - Blocks from the slab allocator are recognised by their address and
+ * go back to the calling thread's slab cache.
+ * - Directly mapped (huge) blocks are unmapped.
+ * - Otherwise it retrieves the original `malloc`'d address, which was
+ * stored just before the aligned pointer, and calls the underlying `free`.
  */
 
 void	lv_free(void **ptr)
@@ -48,7 +51,14 @@ void	lv_free(void **ptr)
 	if (!ptr || !*ptr)
 		return ;
 	pp = *ptr;
-	free(((void **)pp)[-1]);
+	if (LV_ALLOC_STATS && !lv_slab_owns(pp))
+		_lv_stat_free(pp);
+	if (lv_slab_owns(pp))
+		lv_slab_free(pp);
+	else if (_lv_huge_owns(pp))
+		_lv_huge_free(pp);
+	else
+		free(((void **)pp)[-1]);
 	*ptr = NULL;
 }
 
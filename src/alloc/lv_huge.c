@@ -0,0 +1,294 @@
+/**
+ * lv_huge.c
+ *
+ * Copyright (C) 2025 lvzrr <lvzrr@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General
+ * Public License along with this program. If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#define _GNU_SOURCE
+#include "alloc.h"
+#include <sys/mman.h>
+#include <unistd.h>
+
+/*
+ * Huge blocks are anonymous mappings laid out as
+ *
+ *   base                                base + LV_HUGE_HDR
+ *   | mapping length | ... | base | 1   | user data ...
+ *
+ * The word right before the user pointer is where `lv_alloc_align`
+ * keeps the raw malloc pointer. malloc pointers are always even, so
+ * storing the mapping base with its low bit set tells the two apart
+ * without any global lookup.
+ */
+
+/*
+ * Function: _huge_len
+ * -------------------
+ * Mapping length for a block of `size` bytes: header included, rounded
+ * up to whole pages. Returns 0 on overflow.
+ */
+
+LV_INLINE static inline size_t	_huge_len(size_t size)
+{
+	size_t	pg;
+
+	pg = (size_t)sysconf(_SC_PAGESIZE);
+	if (size > SIZE_MAX - LV_HUGE_HDR - pg)
+		return (0);
+	return ((size + LV_HUGE_HDR + pg - 1) & ~(pg - 1));
+}
+
+/*
+ * Function: _huge_reserve
+ * -----------------------
+ * Maps `len` bytes, starting on a LV_HUGE_PAGE boundary when the block
+ * is large enough for a huge page. The mapping is over-reserved by one
+ * huge page and trimmed, since mmap only guarantees page alignment.
+ */
+
+static t_u8	*_huge_reserve(size_t len)
+{
+	t_u8	*raw;
+	t_u8	*base;
+	size_t	head;
+
+	if (len < LV_HUGE_PAGE || len > SIZE_MAX - LV_HUGE_PAGE)
+	{
+		raw = mmap(NULL, len, PROT_READ | PROT_WRITE,
+				MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		return (raw == MAP_FAILED ? NULL : raw);
+	}
+	raw = mmap(NULL, len + LV_HUGE_PAGE, PROT_READ | PROT_WRITE,
+			MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (raw == MAP_FAILED)
+		return (NULL);
+	base = (t_u8 *)(((t_uptr)raw + LV_HUGE_PAGE - 1)
+			& ~(t_uptr)(LV_HUGE_PAGE - 1));
+	head = (size_t)(base - raw);
+	if (head)
+		munmap(raw, head);
+	if (LV_HUGE_PAGE - head)
+		munmap(base + len, LV_HUGE_PAGE - head);
+	return (base);
+}
+
+/*
+ * Function: _huge_advise
+ * ----------------------
+ * Asks for transparent huge pages on a mapping that can use them.
+ */
+
+static void	_huge_advise(t_u8 *base, size_t len)
+{
+#ifdef MADV_HUGEPAGE
+	if (len >= LV_HUGE_PAGE)
+		madvise(base, len, MADV_HUGEPAGE);
+#else
+	(void)base;
+	(void)len;
+#endif
+}
+
+/*
+ * Function: _huge_map
+ * -------------------
+ * Maps `len` bytes on a huge page boundary (see `_huge_reserve`) and
+ * asks for transparent huge pages.
+ */
+
+static t_u8	*_huge_map(size_t len)
+{
+	t_u8	*base;
+
+	base = _huge_reserve(len);
+	if (base)
+		_huge_advise(base, len);
+	return (base);
+}
+
+/*
+ * Function: _huge_populate
+ * ------------------------
+ * Faults the whole mapping in up front. Done after the huge page advice
+ * (unlike MAP_POPULATE, which would fault in small pages first), with
+ * MADV_POPULATE_WRITE when the kernel has it and a page walk otherwise.
+ */
+
+static void	_huge_populate(t_u8 *base, size_t len)
+{
+	volatile t_u8	*p;
+	size_t			pg;
+	size_t			i;
+
+#ifdef MADV_POPULATE_WRITE
+	if (!madvise(base, len, MADV_POPULATE_WRITE))
+		return ;
+#endif
+	pg = (size_t)sysconf(_SC_PAGESIZE);
+	p = base;
+	i = 0;
+	while (i < len)
+	{
+		p[i] = 0;
+		i += pg;
+	}
+}
+
+/*
+ * Function: _lv_huge_alloc
+ * ------------------------
+ * Allocates a block of `size` bytes straight from the kernel.
+ *
+ * Parameters:
+ * size  - The size of the block in bytes.
+ * flags - `LV_ALLOC_POPULATE` to fault every page in before returning.
+ *
+ * Returns:
+ * A zero-filled block aligned to LV_HUGE_HDR, or NULL on failure.
+ */
+
+void	*_lv_huge_alloc(size_t size, int flags)
+{
+	t_u8	*base;
+	t_u8	*p;
+	size_t	len;
+
+	len = _huge_len(size);
+	if (!len)
+		return (NULL);
+	base = _huge_map(len);
+	if (!base)
+		return (NULL);
+	if (flags & LV_ALLOC_POPULATE)
+		_huge_populate(base, len);
+	*(size_t *)base = len;
+	p = base + LV_HUGE_HDR;
+	((void **)p)[-1] = (void *)((t_uptr)base | 1);
+	if (LV_ALLOC_STATS)
+		_lv_stat_alloc(p, size);
+	return (p);
+}
+
+/*
+ * Function: _lv_huge_owns
+ * -----------------------
+ * Tells whether a non-slab `lv_alloc` block is a huge block.
+ */
+
+bool	_lv_huge_owns(const void *ptr)
+{
+	return (((t_uptr)((void *const *)ptr)[-1] & 1) != 0);
+}
+
+/*
+ * Function: _lv_huge_size
+ * -----------------------
+ * Returns the usable size of a huge block: its mapping minus the header.
+ * Bytes past it are zero until the block grows over them.
+ */
+
+size_t	_lv_huge_size(const void *ptr)
+{
+	return (*(size_t *)((t_uptr)((void *const *)ptr)[-1] & ~(t_uptr)1)
+		- LV_HUGE_HDR);
+}
+
+/*
+ * Function: _huge_move
+ * --------------------
+ * Moves the `old` byte mapping at `base` to a new `len` byte one with
+ * mremap, onto a destination reserved by `_huge_reserve` so that it
+ * keeps its huge page alignment. Returns the new base, or MAP_FAILED.
+ */
+
+static t_u8	*_huge_move(t_u8 *base, size_t old, size_t len)
+{
+	t_u8	*dst;
+	t_u8	*moved;
+
+	if (len < LV_HUGE_PAGE)
+		return (mremap(base, old, len, MREMAP_MAYMOVE));
+	dst = _huge_reserve(len);
+	if (!dst)
+		return (MAP_FAILED);
+	moved = mremap(base, old, len, MREMAP_MAYMOVE | MREMAP_FIXED, dst);
+	if (moved == MAP_FAILED)
+		munmap(dst, len);
+	return (moved);
+}
+
+/*
+ * Function: _lv_huge_resize
+ * -------------------------
+ * Resizes a huge block with mremap: the kernel moves page table entries
+ * instead of copying, and new pages come in zero-filled.
+ *
+ * Parameters:
+ * ptr  - A huge block.
+ * size - The new size in bytes.
+ *
+ * Returns:
+ * The (possibly moved) block, or NULL on failure, in which case `ptr`
+ * is unchanged.
+ *
+ * Notes:
+ * - The mapping is grown in place when the address space after it is
+ * free. Otherwise it moves to a fresh LV_HUGE_PAGE aligned range, so a
+ * moved block still starts on a huge page boundary.
+ */
+
+void	*_lv_huge_resize(void *ptr, size_t size)
+{
+	t_u8	*base;
+	t_u8	*p;
+	size_t	old;
+	size_t	len;
+
+	base = (t_u8 *)((t_uptr)((void **)ptr)[-1] & ~(t_uptr)1);
+	len = _huge_len(size);
+	if (!len)
+		return (NULL);
+	old = *(size_t *)base;
+	if (len == old)
+		return (ptr);
+	p = mremap(base, old, len, 0);
+	if (p == MAP_FAILED)
+		p = _huge_move(base, old, len);
+	if (p == MAP_FAILED)
+		return (NULL);
+	base = p;
+	if (len > old)
+		_huge_advise(base, len);
+	*(size_t *)base = len;
+	p = base + LV_HUGE_HDR;
+	((void **)p)[-1] = (void *)((t_uptr)base | 1);
+	return (p);
+}
+
+/*
+ * Function: _lv_huge_free
+ * -----------------------
+ * Unmaps a huge block.
+ */
+
+void	_lv_huge_free(void *ptr)
+{
+	t_u8	*base;
+
+	base = (t_u8 *)((t_uptr)((void **)ptr)[-1] & ~(t_uptr)1);
+	munmap(base, *(size_t *)base);
+}
@@ -34,8 +34,10 @@
  *   Pointer to the new memory block, or NULL on failure.
  *
  * Notes:
- *   - Always frees the original pointer.
- *   - Returns NULL if size is zero.
+ *   - Resizes the block in place when it can (see `_lv_regrow`); the
+ *   original pointer is invalid afterwards.
+ *   - Frees the original pointer and returns NULL if size is zero or
+ *   the allocation fails.
  */
 
 void	*lv_realloc(void *ptr, size_t n, size_t size)
@@ -46,13 +48,8 @@ void	*lv_realloc(void *ptr, size_t n, size_t size)
 		return (lv_free(&ptr), NULL);
 	if (!ptr)
 		return (lv_alloc(size));
-	p = lv_alloc(size);
+	p = _lv_regrow(ptr, n, size, false);
 	if (!p)
-		return (lv_free(&ptr), NULL);
-	if (size < n)
-		n = size;
-	lv_memmove(p, ptr, n);
-	if (ptr)
 		lv_free(&ptr);
 	return (p);
 }
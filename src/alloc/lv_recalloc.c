@@ -23,7 +23,8 @@
 /*
  * Function: lv_recalloc
  * ---------------------
- * Reallocates memory to a new size and zeroes the entire new block.
+ * Reallocates memory to a new size and zeroes everything past the copied
+ * bytes.
  *
  * Parameters:
  *   ptr  - original memory block (can be NULL)
@@ -34,8 +35,11 @@
  *   Pointer to the new memory block, or NULL on failure.
  *
  * Notes:
- *   - Always frees the original pointer.
- *   - Zero-initializes the full new memory region.
+ *   - Resizes the block in place when it can (see `_lv_regrow`); the
+ *   original pointer is invalid afterwards.
+ *   - Everything past the first `n` bytes is zeroed.
+ *   - Frees the original pointer and returns NULL if size is zero or
+ *   the allocation fails.
  */
 
 void	*lv_recalloc(void *ptr, size_t n, size_t size)
@@ -46,13 +50,8 @@ void	*lv_recalloc(void *ptr, size_t n, size_t size)
 		return (lv_free(&ptr), NULL);
 	if (!ptr)
 		return (lv_calloc(size, 1));
-	p = lv_calloc(size, 1);
+	p = _lv_regrow(ptr, n, size, true);
 	if (!p)
-		return (lv_free(&ptr), NULL);
-	if (size < n)
-		n = size;
-	lv_memmove(p, ptr, n);
-	if (ptr)
 		lv_free(&ptr);
 	return (p);
 }
@@ -0,0 +1,144 @@
+/**
+ * lv_regrow.c
+ *
+ * Copyright (C) 2025 lvzrr <lvzrr@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General
+ * Public License along with this program. If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#include "alloc.h"
+
+/*
+ * Function: _default_slack
+ * ------------------------
+ * Whether the malloc backed block `ptr` sits within the slack
+ * `lv_alloc` leaves (a pointer plus DEF_ALIGN - 1 bytes) from its raw
+ * allocation. Blocks from `lv_alloc_align` with a larger alignment may
+ * sit further in, and cannot be regrown through `realloc`.
+ */
+
+static bool	_default_slack(void *ptr)
+{
+	return ((size_t)((t_u8 *)ptr - (t_u8 *)((void **)ptr)[-1])
+		<= sizeof(void *) + (DEF_ALIGN - 1));
+}
+
+/*
+ * Function: _lv_regrow
+ * --------------------
+ * Resizes a block returned by `lv_alloc`, in place whenever possible.
+ * Shared growth path of `lv_extend`, `lv_extend_zero`, `lv_realloc` and
+ * `lv_recalloc`.
+ *
+ * Parameters:
+ * ptr  - The block to resize (not NULL).
+ * n    - The number of bytes of `ptr` holding data.
+ * size - The new size in bytes.
+ * zero - Whether bytes `n` to `size` must be zeroed.
+ *
+ * Returns:
+ * The resized block, or NULL on failure, in which case `ptr` is left
+ * untouched and still owned by the caller.
+ *
+ * Notes:
+ * - A slab block that already has room for `size` bytes (its class is a
+ * power of two) is returned as is. Otherwise the data moves to a new
+ * `lv_alloc` block, as it does for any block growing past
+ * LV_HUGE_THRESHOLD (which then gets its own mapping).
+ * - A huge block is resized with mremap (`_lv_huge_resize`), so its
+ * pages are never copied.
+ * - A malloc backed block is grown with `realloc` on the raw pointer
+ * stored before it, keeping the same slack as `lv_alloc`. The
+ * allocator can then extend it in place, and glibc grows its large,
+ * mmap'd blocks with mremap instead of copying. Data is only shifted
+ * in the rare case where the new raw pointer has a different alignment
+ * offset. Blocks with a larger slack (`lv_alloc_align` with an
+ * alignment above DEF_ALIGN) are copied to a new `lv_alloc` block
+ * instead, so the result is only guaranteed DEF_ALIGN alignment.
+ * - Only the new tail is zeroed, never the data that is kept, and only
+ * up to where it can hold stale bytes: pages mremap adds to a huge
+ * block, and a new huge block, come zero-filled from the kernel and are
+ * left untouched.
+ */
+
+void	*_lv_regrow(void *ptr, size_t n, size_t size, bool zero)
+{
+	t_u8	*raw;
+	t_u8	*p;
+	size_t	off;
+	size_t	old;
+	size_t	dirty;
+
+	if (n > size)
+		n = size;
+	dirty = size;
+	if (lv_slab_owns(ptr) && size <= lv_slab_size(ptr))
+	{
+		p = ptr;
+		if (LV_ALLOC_STATS)
+			_lv_stat_resize(0, 0, false, 0);
+	}
+	else if (!lv_slab_owns(ptr) && _lv_huge_owns(ptr))
+	{
+		old = 0;
+		if (LV_ALLOC_STATS)
+			old = _lv_stat_block(ptr);
+		dirty = _lv_huge_size(ptr);
+		p = _lv_huge_resize(ptr, size);
+		if (!p)
+			return (NULL);
+		if (LV_ALLOC_STATS)
+			_lv_stat_resize(old, _lv_stat_block(p), false, 0);
+	}
+	else if (lv_slab_owns(ptr) || size >= LV_HUGE_THRESHOLD
+		|| !_default_slack(ptr))
+	{
+		p = lv_alloc(size);
+		if (!p)
+			return (NULL);
+		lv_memcpy(p, ptr, n);
+		lv_free(&ptr);
+		if (size >= LV_HUGE_THRESHOLD)
+			dirty = n;
+		if (LV_ALLOC_STATS)
+			_lv_stat_resize(0, 0, true, n);
+	}
+	else
+	{
+		if (size > SIZE_MAX - sizeof(void *) - (DEF_ALIGN - 1))
+			return (NULL);
+		raw = ((void **)ptr)[-1];
+		off = (size_t)((t_u8 *)ptr - raw);
+		old = 0;
+		if (LV_ALLOC_STATS)
+			old = _lv_stat_block(ptr);
+		raw = realloc(raw, sizeof(void *) + (DEF_ALIGN - 1) + size);
+		if (!raw)
+			return (NULL);
+		p = (t_u8 *)(((t_uptr)raw + sizeof(void *) + (DEF_ALIGN - 1))
+				& ~(t_uptr)(DEF_ALIGN - 1));
+		if (p != raw + off)
+			lv_memmove(p, raw + off, n);
+		((void **)p)[-1] = raw;
+		if (LV_ALLOC_STATS)
+			_lv_stat_resize(old, _lv_stat_block(p),
+				p != (t_u8 *)ptr, n);
+	}
+	if (dirty > size)
+		dirty = size;
+	if (zero && dirty > n)
+		lv_bzero(p + n, dirty - n);
+	return (p);
+}
@@ -0,0 +1,365 @@
+/**
+ * lv_slab.c
+ *
+ * Copyright (C) 2025 lvzrr <lvzrr@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General
+ * Public License along with this program. If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#include "alloc.h"
+#include <pthread.h>
+#include <sys/mman.h>
+
+/*
+ * The slab region: LV_SLAB_REGION bytes of address space reserved once,
+ * carved into 64 KiB slabs by bumping `g_slab_top`. Each slab holds
+ * blocks of a single size class, recorded in `g_slab_class`, so a block
+ * needs no header at all: its class is found from its address.
+ */
+
+static t_u8			*g_slab_base;
+static size_t		g_slab_top;
+static t_u8			g_slab_class[LV_SLAB_REGION >> LV_SLAB_SHIFT];
+static pthread_once_t	g_slab_once = PTHREAD_ONCE_INIT;
+
+/*
+ * Global free lists, one per class, holding batches of blocks handed
+ * back by the thread caches. Each head packs the region offset of the
+ * first batch (plus one, 0 meaning empty) in its low 32 bits and an ABA
+ * tag in its high 32 bits, so it can be updated with a plain 64-bit CAS.
+ * The next-batch link in each batch head is packed the same way, which
+ * caps LV_SLAB_REGION at 4 GiB (checked in alloc.h).
+ */
+
+static t_u64		g_slab_free[LV_SLAB_CLASSES];
+
+/*
+ * Per-thread caches: a free list and a bump range per class. The fast
+ * paths of `lv_slab_alloc` and `lv_slab_free` only touch these.
+ */
+
+static __thread void	*g_tc_list[LV_SLAB_CLASSES];
+static __thread t_u32	g_tc_count[LV_SLAB_CLASSES];
+static __thread t_u8	*g_tc_bump[LV_SLAB_CLASSES];
+static __thread t_u8	*g_tc_end[LV_SLAB_CLASSES];
+static __thread bool	g_tc_keyed;
+static pthread_key_t	g_tc_key;
+
+/*
+ * Slabs live outside the malloc heap, so a leak checker would not see
+ * the pointers stored in them. When LeakSanitizer is linked in, every
+ * slab is registered with it as a root region.
+ */
+
+extern void	__lsan_register_root_region(const void *p, size_t size)
+			__attribute__((weak));
+
+/*
+ * Function: _class_of
+ * -------------------
+ * Returns the size class of a request: 0 for up to LV_SLAB_MIN bytes,
+ * then one class per power of two.
+ */
+
+LV_INLINE static inline int	_class_of(size_t size)
+{
+	if (size <= LV_SLAB_MIN)
+		return (0);
+	return (64 - __builtin_clzll(size - 1) - __builtin_ctzll(LV_SLAB_MIN));
+}
+
+/*
+ * Function: _global_push / _global_pop
+ * ------------------------------------
+ * Lock-free stack of batches. A batch is a NULL-terminated list linked
+ * through the first word of each block; the second word of its first
+ * block holds the next batch (low 32 bits) and the batch length (high
+ * 32 bits). A pop may read that word from a block another thread has
+ * just taken, but the tag makes its CAS fail, and the region is never
+ * unmapped, so the read itself is harmless.
+ */
+
+static void	_global_push(int c, void *head, t_u32 n)
+{
+	t_u64	old;
+	t_u64	new;
+
+	old = __atomic_load_n(&g_slab_free[c], __ATOMIC_RELAXED);
+	do
+	{
+		__atomic_store_n((t_u64 *)head + 1,
+			(old & 0xFFFFFFFFULL) | ((t_u64)n << 32), __ATOMIC_RELAXED);
+		new = ((t_u64)((t_u8 *)head - g_slab_base) + 1)
+			| (((old >> 32) + 1) << 32);
+	}
+	while (!__atomic_compare_exchange_n(&g_slab_free[c], &old, new, false,
+			__ATOMIC_RELEASE, __ATOMIC_RELAXED));
+}
+
+static void	*_global_pop(int c, t_u32 *n)
+{
+	t_u64	old;
+	t_u64	new;
+	t_u64	meta;
+	t_u8	*head;
+
+	old = __atomic_load_n(&g_slab_free[c], __ATOMIC_ACQUIRE);
+	do
+	{
+		if (!(t_u32)old)
+			return (NULL);
+		head = g_slab_base + (t_u32)old - 1;
+		meta = __atomic_load_n((t_u64 *)head + 1, __ATOMIC_RELAXED);
+		new = (meta & 0xFFFFFFFFULL) | (((old >> 32) + 1) << 32);
+	}
+	while (!__atomic_compare_exchange_n(&g_slab_free[c], &old, new, false,
+			__ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE));
+	*n = (t_u32)(meta >> 32);
+	return (head);
+}
+
+/*
+ * Function: _tc_flush
+ * -------------------
+ * Moves the first `n` blocks of the calling thread's list for class `c`
+ * to the global free list as one batch.
+ */
+
+static void	_tc_flush(int c, t_u32 n)
+{
+	void	*head;
+	void	*tail;
+	t_u32	i;
+
+	head = g_tc_list[c];
+	tail = head;
+	i = 1;
+	while (i++ < n)
+		tail = *(void **)tail;
+	g_tc_list[c] = *(void **)tail;
+	*(void **)tail = NULL;
+	g_tc_count[c] -= n;
+	_global_push(c, head, n);
+}
+
+/*
+ * Function: _tc_release
+ * ---------------------
+ * Thread exit hook: hands every cached block, including the untouched
+ * tail of the bump ranges, back to the global free lists.
+ */
+
+static void	_tc_release(void *unused)
+{
+	int		c;
+	size_t	bs;
+
+	(void)unused;
+	c = 0;
+	while (c < LV_SLAB_CLASSES)
+	{
+		bs = (size_t)LV_SLAB_MIN << c;
+		while (g_tc_bump[c] && g_tc_bump[c] < g_tc_end[c])
+		{
+			*(void **)g_tc_bump[c] = g_tc_list[c];
+			g_tc_list[c] = g_tc_bump[c];
+			g_tc_count[c]++;
+			g_tc_bump[c] += bs;
+		}
+		if (g_tc_count[c])
+			_tc_flush(c, g_tc_count[c]);
+		g_tc_bump[c] = NULL;
+		g_tc_end[c] = NULL;
+		c++;
+	}
+	g_tc_keyed = false;
+}
+
+/*
+ * Function: _slab_init
+ * --------------------
+ * Reserves the slab region and the thread exit key, once per process.
+ * The region is mapped with MAP_NORESERVE: only the pages actually used
+ * by slabs cost memory.
+ */
+
+static void	_slab_init(void)
+{
+	void	*p;
+
+	if (pthread_key_create(&g_tc_key, _tc_release))
+		return ;
+	p = mmap(NULL, LV_SLAB_REGION, PROT_READ | PROT_WRITE,
+			MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+	if (p != MAP_FAILED)
+		__atomic_store_n(&g_slab_base, (t_u8 *)p, __ATOMIC_RELEASE);
+}
+
+/*
+ * Function: _tc_register
+ * ----------------------
+ * First use of the allocator by a thread: makes sure the region exists
+ * and arms the thread exit hook.
+ */
+
+static bool	_tc_register(void)
+{
+	pthread_once(&g_slab_once, _slab_init);
+	if (!g_slab_base)
+		return (false);
+	pthread_setspecific(g_tc_key, &g_tc_keyed);
+	g_tc_keyed = true;
+	return (true);
+}
+
+/*
+ * Function: _slab_refill
+ * ----------------------
+ * Slow path of `lv_slab_alloc`, taken when the thread's list for class
+ * `c` is empty: bump from the thread's current slab, else take a batch
+ * from the global list, else carve a new slab.
+ */
+
+static void	*_slab_refill(int c)
+{
+	size_t	bs;
+	size_t	off;
+	t_u8	*p;
+	t_u32	n;
+
+	if (!g_tc_keyed && !_tc_register())
+		return (NULL);
+	bs = (size_t)LV_SLAB_MIN << c;
+	if (g_tc_bump[c] < g_tc_end[c])
+		return (p = g_tc_bump[c], g_tc_bump[c] += bs, p);
+	p = _global_pop(c, &n);
+	if (p)
+	{
+		g_tc_list[c] = *(void **)p;
+		g_tc_count[c] = n - 1;
+		return (p);
+	}
+	off = __atomic_fetch_add(&g_slab_top, (size_t)1 << LV_SLAB_SHIFT,
+			__ATOMIC_RELAXED);
+	if (off >= LV_SLAB_REGION)
+		return (NULL);
+	p = g_slab_base + off;
+	g_slab_class[off >> LV_SLAB_SHIFT] = (t_u8)c;
+	if (__lsan_register_root_region)
+		__lsan_register_root_region(p, (size_t)1 << LV_SLAB_SHIFT);
+	g_tc_bump[c] = p + bs;
+	g_tc_end[c] = p + ((size_t)1 << LV_SLAB_SHIFT);
+	return (p);
+}
+
+/*
+ * Function: lv_slab_alloc
+ * -----------------------
+ * Allocates a block from the size-class slab allocator.
+ *
+ * Parameters:
+ * size - The size of the memory block, at most LV_SLAB_MAX bytes.
+ *
+ * Returns:
+ * A block of the smallest power-of-two class holding `size` bytes,
+ * aligned to its class size (so at least to DEF_ALIGN), or NULL if
+ * `size` is too large or the slab region is exhausted.
+ *
+ * Notes:
+ * - The fast path pops the calling thread's free list for the class:
+ * O(1), no lock and no atomic operation. Threads only meet on the
+ * global lists, and then a whole batch moves with one CAS.
+ * - Blocks have no header. Free them with `lv_slab_free`, or with
+ * `lv_free` when they came from `lv_alloc`.
+ */
+
+void	*lv_slab_alloc(size_t size)
+{
+	void	*p;
+	int		c;
+
+	if (size > LV_SLAB_MAX)
+		return (NULL);
+	c = _class_of(size);
+	p = g_tc_list[c];
+	if (!p)
+		p = _slab_refill(c);
+	else
+	{
+		g_tc_list[c] = *(void **)p;
+		g_tc_count[c]--;
+	}
+	if (LV_ALLOC_STATS && p)
+		_lv_stat_alloc(p, size);
+	return (p);
+}
+
+/*
+ * Function: lv_slab_owns
+ * ----------------------
+ * Tells whether `ptr` points into the slab region.
+ */
+
+bool	lv_slab_owns(const void *ptr)
+{
+	t_u8	*base;
+
+	base = __atomic_load_n(&g_slab_base, __ATOMIC_RELAXED);
+	return (base && (t_uptr)ptr - (t_uptr)base < LV_SLAB_REGION);
+}
+
+/*
+ * Function: lv_slab_size
+ * ----------------------
+ * Returns the usable size of a slab block (the size of its class).
+ */
+
+size_t	lv_slab_size(const void *ptr)
+{
+	return ((size_t)LV_SLAB_MIN << g_slab_class[((t_uptr)ptr
+				- (t_uptr)g_slab_base) >> LV_SLAB_SHIFT]);
+}
+
+/*
+ * Function: lv_slab_free
+ * ----------------------
+ * Returns a block to the calling thread's cache.
+ *
+ * Parameters:
+ * ptr - A block returned by `lv_slab_alloc`, possibly by another thread.
+ *
+ * Returns:
+ * None.
+ *
+ * Notes:
+ * - Once a thread caches LV_SLAB_TCACHE blocks of a class, half of them
+ * move to the global list as one batch, so memory freed by a consumer
+ * thread flows back to producer threads.
+ */
+
+void	lv_slab_free(void *ptr)
+{
+	int	c;
+
+	if (LV_ALLOC_STATS)
+		_lv_stat_free(ptr);
+	if (!g_tc_keyed)
+		_tc_register();
+	c = g_slab_class[((t_uptr)ptr - (t_uptr)g_slab_base) >> LV_SLAB_SHIFT];
+	*(void **)ptr = g_tc_list[c];
+	g_tc_list[c] = ptr;
+	if (++g_tc_count[c] >= LV_SLAB_TCACHE)
+		_tc_flush(c, LV_SLAB_TCACHE / 2);
+}
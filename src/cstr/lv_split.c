@@ -37,88 +37,115 @@
  * Notes:
  * - The caller is responsible for freeing the allocated memory for each
  * substring and the array itself.
- * - Helper functions `count_words`, `eat_literal`, and `free_words` are used.
+ * - Words are delimited with `lv_memchr_not` / `lv_memchr_any` over a
+ * one-byte `t_byteset`; `lv_split_any` is the same with several
+ * delimiters.
+ * - On an allocation failure every substring made so far is released.
  */
 
-static unsigned int	count_words(char *str, char set)
+static size_t	count_words(const char *str, const char *end,
+	const t_byteset *bs)
 {
-	unsigned int	iw;
-	unsigned int	wc;
+	size_t	wc;
 
-	iw = 0;
 	wc = 0;
-	while (*str)
+	while (str && str < end)
 	{
-		if (!iw && *str != set)
-		{
-			iw = 1;
-			wc++;
-		}
-		if (iw && *str == set)
-			iw = 0;
-		str++;
+		str = lv_memchr_not(str, (size_t)(end - str), bs);
+		if (!str)
+			break ;
+		wc++;
+		str = lv_memchr_any(str, (size_t)(end - str), bs);
 	}
 	return (wc);
 }
 
-static char	*eat_literal(char *str, char set)
+static char	*eat_literal(const char *str, size_t len)
 {
-	int		i;
 	char	*out;
 
-	i = 0;
-	while (str[i] && str[i] != set)
-		i++;
-	out = (char *)lv_alloc(i + 1);
+	out = (char *)lv_alloc(len + 1);
 	if (!out)
 		return (NULL);
-	i = 0;
-	while (str[i] && str[i] != set)
-	{
-		out[i] = str[i];
-		i++;
-	}
-	out[i] = '\0';
+	lv_memcpy(out, str, len);
+	out[len] = '\0';
 	return (out);
 }
 
-static int	fill_words(const char *str, char set, char **out)
+static int	fill_words(const char *str, const char *end,
+	const t_byteset *bs, char **out)
 {
-	unsigned int	i;
-	unsigned int	j;
+	const char	*w;
+	size_t		j;
 
-	i = 0;
 	j = 0;
-	while (str[i])
+	while (str < end)
 	{
-		if (str[i] != set)
-		{
-			out[j] = eat_literal((char *)str + i, set);
-			if (!out[j])
-				return (lv_free_array((void ***)&out), 0);
-			j++;
-			while (str[i] && str[i] != set)
-				i++;
-			continue ;
-		}
-		i++;
+		w = lv_memchr_not(str, (size_t)(end - str), bs);
+		if (!w)
+			break ;
+		str = lv_memchr_any(w, (size_t)(end - w), bs);
+		if (!str)
+			str = end;
+		out[j] = eat_literal(w, (size_t)(str - w));
+		if (!out[j])
+			return (0);
+		j++;
 	}
 	return (1);
 }
 
-char	**lv_split(const char *str, char set)
+static char	**split_set(const char *str, const t_byteset *bs)
 {
-	char			**out;
-	unsigned int	wc;
+	char		**out;
+	const char	*end;
+	size_t		wc;
 
-	if (!str)
-		return (NULL);
-	wc = count_words((char *)str, set);
-	out = (char **)lv_alloc((wc + 1) * sizeof(char *));
+	end = str + lv_strlen(str);
+	wc = count_words(str, end, bs);
+	out = (char **)lv_calloc(wc + 1, sizeof(char *));
 	if (!out)
 		return (NULL);
-	out[wc] = NULL;
-	if (!fill_words(str, set, out))
+	if (!fill_words(str, end, bs, out))
 		return (lv_free_array((void ***)&out), NULL);
 	return (out);
 }
+
+char	**lv_split(const char *str, char set)
+{
+	t_byteset	bs;
+
+	if (!str)
+		return (NULL);
+	lv_byteset_init(&bs, &set, 1);
+	return (split_set(str, &bs));
+}
+
+/*
+ * Function: lv_split_any
+ * ----------------------
+ * Splits a string on any of several delimiter characters, e.g. " \t\n".
+ * Runs of delimiters produce no empty substrings, as with `lv_split`.
+ *
+ * Parameters:
+ * str - The string to be split.
+ * set - A null-terminated string holding every delimiter character.
+ *
+ * Returns:
+ * A dynamically allocated, NULL-terminated array of strings on success.
+ * NULL if `str` or `set` is NULL or if memory allocation fails.
+ *
+ * Notes:
+ * - The caller is responsible for freeing the array and every substring
+ * (e.g. with `lv_free_array`).
+ */
+
+char	**lv_split_any(const char *str, const char *set)
+{
+	t_byteset	bs;
+
+	if (!str || !set)
+		return (NULL);
+	lv_byteset_init(&bs, set, lv_strlen(set));
+	return (split_set(str, &bs));
+}
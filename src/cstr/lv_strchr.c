@@ -37,7 +37,8 @@
  * - This function is optimized to search for the character `c` in blocks of `t_u64` (unsigned 64-bit integers)
  * after handling the initial bytes to align the string pointer.
  * - It uses `__hasz64` to check for a null byte within a 64-bit word and `_lookup_u64`
- * to find the character `c` within a 64-bit word.
+ * to find the character `c` within a 64-bit word. The word holding the terminator
+ * is finished byte by byte, so a match right before it is not missed.
  * - The `cstr.h` header is presumed to define `t_u64`, `t_uptr`, `__hasz64`, and `_populate`.
  */
 
@@ -53,8 +54,10 @@ char	*lv_strchr(const char *s, int c)
 	while (((t_uptr)s2) % sizeof(t_u64) != 0
 		&& *s2 != (char)c && *s2 != '\0')
 		s2++;
-	if (*s2 == c)
+	if (*s2 == (char)c)
 		return (s2);
+	if (*s2 == '\0')
+		return (NULL);
 	w = (t_u64 *)s2;
 	while (!__hasz64(w[0]))
 	{
@@ -63,5 +66,10 @@ char	*lv_strchr(const char *s, int c)
 			return (((char *)w) + idx);
 		w++;
 	}
+	s2 = (char *)w;
+	while (*s2 != (char)c && *s2 != '\0')
+		s2++;
+	if (*s2 == (char)c)
+		return (s2);
 	return (NULL);
 }
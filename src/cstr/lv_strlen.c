@@ -21,11 +21,13 @@
 #include "cstr.h"
 
 /*
- * Function: lv_strlen
- * -------------------
- * Calculates the length of a null-terminated string. This implementation
- * attempts to optimize the length calculation by checking multiple bytes
- * at a time using 64-bit word comparisons.
+ * Function: _lv_strlen_sse2
+ * -------------------------
+ * SSE2 variant of `lv_strlen`. Loads the aligned 16-byte block holding
+ * `str` and shifts the bytes before `str` out of the `pmovmskb` mask, so
+ * there is no byte-wise prologue. After that it checks 64 bytes per step,
+ * folding four blocks with `pminub` so a single compare against zero
+ * tells whether any of them holds the terminator.
  *
  * Parameters:
  * str - The null-terminated string.
@@ -34,39 +36,176 @@
  * The number of characters in `str`, excluding the null terminator.
  *
  * Notes:
- * - Handles unaligned initial bytes.
- * - Uses `t_u64` and `t_u128` for word-sized processing.
- * - Relies on `__hasz64` macro to efficiently check for null bytes
- * within a 64-bit word.
+ * - Aligned loads never straddle a page boundary, so reading past the
+ * terminator (or before `str`) inside a block cannot fault.
  */
 
-#include <stdio.h>
+LV_SSE2 size_t	_lv_strlen_sse2(const char *str)
+{
+	const char	*p;
+	__m128i		z;
+	__m128i		b[4];
+	t_u64		m;
 
-size_t	lv_strlen(const char *str)
+	z = _mm_setzero_si128();
+	p = (const char *)((t_uptr)str & ~(t_uptr)15);
+	m = (t_u32)_mm_movemask_epi8(_mm_cmpeq_epi8(
+				_mm_load_si128((const __m128i *)p), z)) >> ((t_uptr)str & 15);
+	if (m)
+		return (__builtin_ctzll(m));
+	p += 16;
+	while ((t_uptr)p & 63)
+	{
+		m = (t_u32)_mm_movemask_epi8(_mm_cmpeq_epi8(
+					_mm_load_si128((const __m128i *)p), z));
+		if (m)
+			return ((size_t)(p - str) + __builtin_ctzll(m));
+		p += 16;
+	}
+	while (true)
+	{
+		b[0] = _mm_load_si128((const __m128i *)p);
+		b[1] = _mm_load_si128((const __m128i *)(p + 16));
+		b[2] = _mm_load_si128((const __m128i *)(p + 32));
+		b[3] = _mm_load_si128((const __m128i *)(p + 48));
+		if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(
+						_mm_min_epu8(b[0], b[1]), _mm_min_epu8(b[2], b[3])), z)))
+			break ;
+		p += 64;
+	}
+	m = (t_u64)(t_u32)_mm_movemask_epi8(_mm_cmpeq_epi8(b[0], z))
+		| (t_u64)(t_u32)_mm_movemask_epi8(_mm_cmpeq_epi8(b[1], z)) << 16
+		| (t_u64)(t_u32)_mm_movemask_epi8(_mm_cmpeq_epi8(b[2], z)) << 32
+		| (t_u64)(t_u32)_mm_movemask_epi8(_mm_cmpeq_epi8(b[3], z)) << 48;
+	return ((size_t)(p - str) + __builtin_ctzll(m));
+}
+
+/*
+ * Function: _lv_strlen_avx2
+ * -------------------------
+ * AVX2 variant of `lv_strlen`. Same structure as `_lv_strlen_sse2`,
+ * with 32-byte blocks and 128 bytes per step.
+ */
+
+LV_AVX2 size_t	_lv_strlen_avx2(const char *str)
 {
-	const char	*a;
-	ssize_t		lk;
-	const t_u64	*w_64;
+	const char	*p;
+	__m256i		z;
+	__m256i		b[4];
+	t_u64		m;
 
-	if (!str)
-		return (0);
-	a = str;
-	while ((t_uptr)str % sizeof(t_u64))
+	z = _mm256_setzero_si256();
+	p = (const char *)((t_uptr)str & ~(t_uptr)31);
+	m = (t_u32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(
+				_mm256_load_si256((const __m256i *)p), z)) >> ((t_uptr)str & 31);
+	if (m)
+		return (__builtin_ctzll(m));
+	p += 32;
+	while ((t_uptr)p & 127)
 	{
-		if (*str == '\0')
-			return (str - a);
-		str++;
+		m = (t_u32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(
+					_mm256_load_si256((const __m256i *)p), z));
+		if (m)
+			return ((size_t)(p - str) + __builtin_ctzll(m));
+		p += 32;
 	}
-	w_64 = (const t_u64 *)str;
 	while (true)
 	{
-		lk = _lookup_u64(w_64[0], __populate(0));
-		if (lk != -1)
-		{
-			str = (const char *)w_64 + lk;
+		b[0] = _mm256_load_si256((const __m256i *)p);
+		b[1] = _mm256_load_si256((const __m256i *)(p + 32));
+		b[2] = _mm256_load_si256((const __m256i *)(p + 64));
+		b[3] = _mm256_load_si256((const __m256i *)(p + 96));
+		if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_min_epu8(
+						_mm256_min_epu8(b[0], b[1]),
+						_mm256_min_epu8(b[2], b[3])), z)))
 			break ;
-		}
-		w_64++;
+		p += 128;
+	}
+	m = (t_u32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(b[0], z))
+		| (t_u64)(t_u32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(b[1], z)) << 32;
+	if (m)
+		return ((size_t)(p - str) + __builtin_ctzll(m));
+	m = (t_u32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(b[2], z))
+		| (t_u64)(t_u32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(b[3], z)) << 32;
+	return ((size_t)(p - str) + 64 + __builtin_ctzll(m));
+}
+
+/*
+ * Function: _lv_strlen_avx512
+ * ---------------------------
+ * AVX-512 variant of `lv_strlen`. Same structure as `_lv_strlen_sse2`,
+ * with 64-byte blocks, `vptestnmb` producing the zero mask directly, and
+ * 256 bytes per step.
+ */
+
+LV_AVX512 size_t	_lv_strlen_avx512(const char *str)
+{
+	const char	*p;
+	__m512i		b[4];
+	t_u64		m;
+	size_t		k;
+
+	p = (const char *)((t_uptr)str & ~(t_uptr)63);
+	b[0] = _mm512_load_si512(p);
+	m = _mm512_testn_epi8_mask(b[0], b[0]) >> ((t_uptr)str & 63);
+	if (m)
+		return (__builtin_ctzll(m));
+	p += 64;
+	while ((t_uptr)p & 255)
+	{
+		b[0] = _mm512_load_si512(p);
+		m = _mm512_testn_epi8_mask(b[0], b[0]);
+		if (m)
+			return ((size_t)(p - str) + __builtin_ctzll(m));
+		p += 64;
 	}
-	return (str - a);
+	while (true)
+	{
+		b[0] = _mm512_load_si512(p);
+		b[1] = _mm512_load_si512(p + 64);
+		b[2] = _mm512_load_si512(p + 128);
+		b[3] = _mm512_load_si512(p + 192);
+		b[1] = _mm512_min_epu8(_mm512_min_epu8(b[0], b[1]),
+				_mm512_min_epu8(b[2], b[3]));
+		if (_mm512_testn_epi8_mask(b[1], b[1]))
+			break ;
+		p += 256;
+	}
+	k = 0;
+	while (true)
+	{
+		b[0] = _mm512_load_si512(p + k);
+		m = _mm512_testn_epi8_mask(b[0], b[0]);
+		if (m)
+			return ((size_t)(p + k - str) + __builtin_ctzll(m));
+		k += 64;
+	}
+}
+
+/*
+ * Function: lv_strlen
+ * -------------------
+ * Calculates the length of a null-terminated string.
+ *
+ * Parameters:
+ * str - The null-terminated string.
+ *
+ * Returns:
+ * The number of characters in `str`, excluding the null terminator,
+ * or 0 if `str` is NULL.
+ *
+ * Notes:
+ * - The scan is done by the SSE2, AVX2 or AVX-512 variant picked at
+ * load time by `lv_cpu_dispatch`.
+ * - Every variant reads whole aligned blocks, including the bytes before
+ * `str` in its first block and after the terminator in its last one. An
+ * aligned block never spans two pages, so this cannot fault, but tools
+ * like valgrind may report the over-read.
+ */
+
+size_t	lv_strlen(const char *str)
+{
+	if (!str)
+		return (0);
+	return (g_lv_mem.len(str));
 }
@@ -20,6 +20,35 @@
 
 #include "cstr.h"
 
+/*
+ * Function: _bounded_len
+ * ----------------------
+ * Length of `s`, but never looking past `n` bytes: the string only has to
+ * be terminated within the first `n` bytes if it is shorter than `n`.
+ * Scans one page at a time so that no byte beyond the terminator's page
+ * is touched.
+ */
+
+static size_t	_bounded_len(const char *s, size_t n)
+{
+	const char	*z;
+	size_t		i;
+	size_t		w;
+
+	i = 0;
+	while (i < n)
+	{
+		w = 4096 - ((t_uptr)(s + i) & 4095);
+		if (w > n - i)
+			w = n - i;
+		z = lv_memchr(s + i, 0, w);
+		if (z)
+			return ((size_t)(z - s));
+		i += w;
+	}
+	return (n);
+}
+
 /*
  * Function: lv_strnstr
  * --------------------
@@ -40,27 +69,16 @@
  *
  * Notes:
  * - If `n` is 0, the function will not find any matches unless `needle` is empty.
- * - Uses `lv_strlen` and `lv_strncmp`.
+ * - The search area is bounded first (terminator or `n`, whichever comes
+ * first) and then handed to `lv_memmem`.
  */
 
 char	*lv_strnstr(const char *haystack, const char *needle, size_t n)
 {
-	size_t	i;
-	size_t	l;
-
 	if (!needle || !*needle)
 		return ((char *)haystack);
 	if (!haystack || !*haystack)
 		return (NULL);
-	i = 0;
-	l = lv_strlen(needle);
-	if (l > n)
-		return (NULL);
-	while (haystack[i] && (i + l) <= n)
-	{
-		if (!lv_strncmp(&(haystack[i]), needle, l))
-			return ((char *)(&(haystack[i])));
-		i++;
-	}
-	return ((void *) 0);
+	return ((char *)lv_memmem(haystack, _bounded_len(haystack, n),
+			needle, lv_strlen(needle)));
 }
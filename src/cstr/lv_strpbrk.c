@@ -0,0 +1,49 @@
+/**
+ * lv_strpbrk.c
+ *
+ * Copyright (C) 2025 lvzrr <lvzrr@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General
+ * Public License along with this program. If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#include "cstr.h"
+
+/*
+ * Function: lv_strpbrk
+ * --------------------
+ * Locates the first character of `str` that also appears in `set`.
+ *
+ * Parameters:
+ * str - The string to be searched.
+ * set - A null-terminated string holding the characters to look for.
+ *
+ * Returns:
+ * A pointer to the first matching character in `str`, or NULL if none
+ * of the characters of `set` occurs in `str` (or if either is NULL).
+ *
+ * Notes:
+ * - `set` is compiled into a `t_byteset` and `str` is scanned once with
+ * `lv_memchr_any`, instead of re-walking `set` for every character.
+ */
+
+char	*lv_strpbrk(const char *str, const char *set)
+{
+	t_byteset	bs;
+
+	if (!str || !set)
+		return (NULL);
+	lv_byteset_init(&bs, set, lv_strlen(set));
+	return (lv_memchr_any(str, lv_strlen(str), &bs));
+}
@@ -38,46 +38,36 @@
  * - The caller is responsible for freeing the allocated memory.
  * - If `str` is empty or only contains characters from `set`, an empty string is returned.
  * - If `set` is empty, a duplicate of `str` is returned.
+ * - `set` is compiled into a `t_byteset`, so both ends are found in one
+ * pass each with `lv_memchr_not` / `lv_memrchr_not`.
  */
 
-static int	in_set(char c, const char *set)
+char	*lv_strtrim(const char *str, const char *set)
 {
-	int	i;
+	t_byteset	bs;
+	const char	*b;
+	const char	*e;
+	size_t		len;
+	size_t		trimmed_len;
+	char		*out;
 
-	i = 0;
-	while (set[i])
+	if (!str)
+		return (NULL);
+	if (!set || !set[0] || !str[0])
+		return (lv_strdup(str));
+	lv_byteset_init(&bs, set, lv_strlen(set));
+	len = lv_strlen(str);
+	b = lv_memchr_not(str, len, &bs);
+	trimmed_len = 0;
+	if (b)
 	{
-		if (set[i] == c)
-			return (i);
-		i++;
+		e = lv_memrchr_not(b, len - (size_t)(b - str), &bs);
+		trimmed_len = (size_t)(e - b) + 1;
 	}
-	return (-1);
-}
-
-char *lv_strtrim(const char *str, const char *set)
-{
-    size_t b;
-    size_t e;
-    size_t trimmed_len;
-    char   *out;
-    if (!str)
-        return (NULL);
-    if (!set || !set[0] || !str[0])
-        return (lv_strdup(str));
-    b = 0;
-    e = lv_strlen(str) - 1;
-    while (str[b] && in_set(str[b], set) >= 0)
-        b++;
-    while (e >= b && in_set(str[e], set) >= 0)
-        e--;
-    if (b > e)
-        trimmed_len = 0;
-    else
-        trimmed_len = e - b + 1;
-    out = lv_alloc(trimmed_len + 1);
-    if (!out)
-        return (NULL);
-    lv_memcpy(out, str + b, trimmed_len);
-    out[trimmed_len] = '\0';
-    return (out);
+	out = lv_alloc(trimmed_len + 1);
+	if (!out)
+		return (NULL);
+	lv_memcpy(out, b, trimmed_len);
+	out[trimmed_len] = '\0';
+	return (out);
 }
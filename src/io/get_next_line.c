@@ -26,9 +26,12 @@
 
 static void	*free_buf(char **ptr)
 {
+	void	*t;
+
 	if (!ptr || !*ptr)
 		return (*ptr = NULL, NULL);
-	free(*ptr);
+	t = *ptr;
+	lv_free(&t);
 	*ptr = NULL;
 	return (NULL);
 }
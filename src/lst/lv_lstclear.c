@@ -23,6 +23,7 @@
 void	lv_lstclear(t_list **lst, void (*del)(void *))
 {
 	t_list	*tmp;
+	void	*t;
 
 	if (!lst || !*lst || !del)
 		return ;
@@ -30,7 +31,8 @@ void	lv_lstclear(t_list **lst, void (*del)(void *))
 	{
 		tmp = (*lst)->next;
 		del((*lst)->content);
-		free(*lst);
+		t = *lst;
+		lv_free(&t);
 		*lst = tmp;
 	}
 }
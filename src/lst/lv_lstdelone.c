@@ -22,8 +22,11 @@
 
 void	lv_lstdelone(t_list *lst, void (*del)(void *))
 {
+	void	*t;
+
 	if (!del || !lst)
 		return ;
 	del(lst->content);
-	free(lst);
+	t = lst;
+	lv_free(&t);
 }
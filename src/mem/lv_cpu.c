@@ -0,0 +1,266 @@
+/**
+ * lv_cpu.c
+ *
+ * Copyright (C) 2025 lvzrr <lvzrr@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General
+ * Public License along with this program. If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#include "mem.h"
+#include <cpuid.h>
+#include <unistd.h>
+
+/*
+ * One table per instruction set level. `lv_cpu_dispatch` copies the
+ * selected one into `g_lv_mem`.
+ */
+
+static const t_mem_dispatch	g_sse2 = {
+	.cpy = _lv_memcpy_sse2,
+	.cpy_nt = _lv_memcpy_nt_sse2,
+	.set = _lv_memset_sse2,
+	.move = _lv_memmove_sse2,
+	.cmp = _lv_memcmp_sse2,
+	.eq = _lv_memeq_sse2,
+	.chr = _lv_memchr_sse2,
+	.rchr = _lv_memrchr_sse2,
+	.any = _lv_memchr_any_sse2,
+	.len = _lv_strlen_sse2,
+	.find = _lv_memmem_sse2,
+	.rev = _lv_memrev_sse2,
+};
+
+static const t_mem_dispatch	g_avx2 = {
+	.cpy = _lv_memcpy_avx2,
+	.cpy_nt = _lv_memcpy_nt_avx2,
+	.set = _lv_memset_avx2,
+	.move = _lv_memmove_avx2,
+	.cmp = _lv_memcmp_avx2,
+	.eq = _lv_memeq_avx2,
+	.chr = _lv_memchr_avx2,
+	.rchr = _lv_memrchr_avx2,
+	.any = _lv_memchr_any_avx2,
+	.len = _lv_strlen_avx2,
+	.find = _lv_memmem_avx2,
+	.rev = _lv_memrev_avx2,
+};
+
+static const t_mem_dispatch	g_avx512 = {
+	.cpy = _lv_memcpy_avx512,
+	.cpy_nt = _lv_memcpy_nt_avx512,
+	.set = _lv_memset_avx512,
+	.move = _lv_memmove_avx512,
+	.cmp = _lv_memcmp_avx512,
+	.eq = _lv_memeq_avx512,
+	.chr = _lv_memchr_avx512,
+	.rchr = _lv_memrchr_avx512,
+	.any = _lv_memchr_any_avx512,
+	.len = _lv_strlen_avx512,
+	.find = _lv_memmem_avx512,
+	.rev = _lv_memrev_avx512,
+};
+
+/*
+ * Global dispatch table. It starts out pointing at the SSE2 variants,
+ * which every x86-64 CPU supports, so calls made before `lv_cpu_init`
+ * runs (e.g. from other constructors) are still safe.
+ */
+
+t_mem_dispatch	g_lv_mem = {
+	.cpy = _lv_memcpy_sse2,
+	.cpy_nt = _lv_memcpy_nt_sse2,
+	.set = _lv_memset_sse2,
+	.move = _lv_memmove_sse2,
+	.cmp = _lv_memcmp_sse2,
+	.eq = _lv_memeq_sse2,
+	.chr = _lv_memchr_sse2,
+	.rchr = _lv_memrchr_sse2,
+	.any = _lv_memchr_any_sse2,
+	.len = _lv_strlen_sse2,
+	.find = _lv_memmem_sse2,
+	.rev = _lv_memrev_sse2,
+};
+
+/*
+ * Streaming threshold. It stays at SIZE_MAX (never stream) until
+ * `lv_cpu_init` has measured the cache, or if the size is unknown.
+ */
+
+size_t			g_lv_nt_threshold = SIZE_MAX;
+
+/*
+ * Function: lv_cpu_features
+ * -------------------------
+ * Queries CPUID (through the compiler runtime) for the instruction set
+ * extensions the dispatched routines care about.
+ *
+ * Parameters:
+ * None.
+ *
+ * Returns:
+ * A bitmask of `LV_CPU_SSE2`, `LV_CPU_AVX2` and `LV_CPU_AVX512`.
+ *
+ * Notes:
+ * - `LV_CPU_AVX512` is only reported when F, BW and VL are all present,
+ * matching the target used to build the AVX-512 variants.
+ * - The result is computed once and cached.
+ * - `__builtin_cpu_supports` also checks that the OS saves the wide
+ * register state (XCR0), so a reported feature is safe to use.
+ */
+
+t_u32	lv_cpu_features(void)
+{
+	static t_u32	features;
+
+	if (features)
+		return (features);
+	__builtin_cpu_init();
+	features = LV_CPU_SSE2;
+	if (__builtin_cpu_supports("avx2"))
+		features |= LV_CPU_AVX2;
+	if (__builtin_cpu_supports("avx512f")
+		&& __builtin_cpu_supports("avx512bw")
+		&& __builtin_cpu_supports("avx512vl"))
+		features |= LV_CPU_AVX512;
+	return (features);
+}
+
+/*
+ * Function: lv_cpu_dispatch
+ * -------------------------
+ * Points every entry of `g_lv_mem` at the widest variant allowed by
+ * `features` and supported by the running CPU.
+ *
+ * Parameters:
+ * features - A mask of `LV_CPU_*` flags the caller allows. Flags the
+ * CPU does not support are ignored.
+ *
+ * Returns:
+ * None.
+ *
+ * Notes:
+ * - Called automatically at load time with every feature allowed.
+ * - Can be called again to cap the level (e.g. `LV_CPU_SSE2` to test
+ * or benchmark the narrow paths on a wide machine). It is not meant to
+ * be called while other threads are using the dispatched routines.
+ */
+
+void	lv_cpu_dispatch(t_u32 features)
+{
+	features &= lv_cpu_features();
+	if (features & LV_CPU_AVX512)
+		g_lv_mem = g_avx512;
+	else if (features & LV_CPU_AVX2)
+		g_lv_mem = g_avx2;
+	else
+		g_lv_mem = g_sse2;
+}
+
+/*
+ * Function: _cache_leaf_size
+ * --------------------------
+ * Walks a deterministic cache parameters CPUID leaf (4 on Intel,
+ * 0x8000001D on AMD) and returns the size of the highest level found.
+ */
+
+static size_t	_cache_leaf_size(unsigned int leaf)
+{
+	unsigned int	r[4];
+	unsigned int	sub;
+	unsigned int	level;
+	unsigned int	best;
+	size_t			size;
+
+	if (__get_cpuid_max(leaf & 0x80000000U, NULL) < leaf)
+		return (0);
+	size = 0;
+	best = 0;
+	sub = 0;
+	while (sub < 16)
+	{
+		__cpuid_count(leaf, sub, r[0], r[1], r[2], r[3]);
+		if (!(r[0] & 0x1F))
+			break ;
+		level = (r[0] >> 5) & 0x7;
+		if (level >= best && (r[0] & 0x1F) != 2)
+		{
+			best = level;
+			size = (size_t)(((r[1] >> 22) & 0x3FF) + 1)
+				* (((r[1] >> 12) & 0x3FF) + 1)
+				* ((r[1] & 0xFFF) + 1) * ((size_t)r[2] + 1);
+		}
+		sub++;
+	}
+	return (size);
+}
+
+/*
+ * Function: lv_cpu_cache_size
+ * ---------------------------
+ * Returns the size of the last level data (or unified) cache.
+ *
+ * Parameters:
+ * None.
+ *
+ * Returns:
+ * The cache size in bytes, or 0 if it could not be determined.
+ *
+ * Notes:
+ * - CPUID is tried first; `sysconf` is only used as a fallback for
+ * CPUs that do not expose a deterministic cache leaf.
+ * - The result is computed once and cached.
+ */
+
+size_t	lv_cpu_cache_size(void)
+{
+	static size_t	size;
+	long			sc;
+
+	if (size)
+		return (size);
+	size = _cache_leaf_size(4);
+	if (!size)
+		size = _cache_leaf_size(0x8000001DU);
+# ifdef _SC_LEVEL3_CACHE_SIZE
+	if (!size)
+	{
+		sc = sysconf(_SC_LEVEL3_CACHE_SIZE);
+		if (sc > 0)
+			size = (size_t)sc;
+	}
+# else
+	LV_UNUSED(sc);
+# endif
+	return (size);
+}
+
+/*
+ * Function: lv_cpu_init
+ * ---------------------
+ * Load-time constructor that selects the best variants for this CPU
+ * and sets the streaming threshold to 3/4 of the last level cache, the
+ * point past which a regular copy would evict most of it anyway.
+ */
+
+__attribute__((constructor))
+static void	lv_cpu_init(void)
+{
+	size_t	llc;
+
+	lv_cpu_dispatch(LV_CPU_SSE2 | LV_CPU_AVX2 | LV_CPU_AVX512);
+	llc = lv_cpu_cache_size();
+	if (llc)
+		g_lv_nt_threshold = llc / 4 * 3;
+}
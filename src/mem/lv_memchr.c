@@ -20,12 +20,207 @@
 
 #include "mem.h"
 
+/*
+ * Function: _lv_memchr_sse2
+ * -------------------------
+ * SSE2 variant of `lv_memchr`. Every load is an aligned 16-byte block,
+ * so no read ever crosses a page boundary, even when it covers bytes
+ * outside `[ptr, ptr + n)`. The first block is the one containing `ptr`,
+ * with the bytes before `ptr` shifted out of the `pmovmskb` mask; the
+ * last block has the bytes past `n` masked off. In between, 64 bytes
+ * are compared per step and only tested one block at a time on a hit.
+ *
+ * Parameters:
+ * ptr - A pointer to the memory area to be searched.
+ * c   - The character to search for (treated as an unsigned char).
+ * n   - The number of bytes to search, at least 1.
+ *
+ * Returns:
+ * A pointer to the matching byte, or NULL if it is not found.
+ */
+
+LV_SSE2 void	*_lv_memchr_sse2(const void *ptr, int c, size_t n)
+{
+	const t_u8	*p;
+	__m128i		v;
+	t_u64		m;
+	size_t		off;
+
+	v = _mm_set1_epi8((char)c);
+	off = (t_uptr)ptr & 15;
+	p = (const t_u8 *)ptr - off;
+	m = (t_u32)_mm_movemask_epi8(_mm_cmpeq_epi8(
+				_mm_load_si128((const __m128i *)p), v)) >> off;
+	if (n < 16 - off)
+		m &= (1ULL << n) - 1;
+	if (m)
+		return ((void *)((const t_u8 *)ptr + __builtin_ctzll(m)));
+	if (n <= 16 - off)
+		return (NULL);
+	n -= 16 - off;
+	p += 16;
+	while (n >= 64)
+	{
+		m = (t_u64)(t_u32)_mm_movemask_epi8(_mm_cmpeq_epi8(
+					_mm_load_si128((const __m128i *)p), v))
+			| (t_u64)(t_u32)_mm_movemask_epi8(_mm_cmpeq_epi8(
+					_mm_load_si128((const __m128i *)(p + 16)), v)) << 16
+			| (t_u64)(t_u32)_mm_movemask_epi8(_mm_cmpeq_epi8(
+					_mm_load_si128((const __m128i *)(p + 32)), v)) << 32
+			| (t_u64)(t_u32)_mm_movemask_epi8(_mm_cmpeq_epi8(
+					_mm_load_si128((const __m128i *)(p + 48)), v)) << 48;
+		if (m)
+			return ((void *)(p + __builtin_ctzll(m)));
+		p += 64;
+		n -= 64;
+	}
+	while (n)
+	{
+		m = (t_u32)_mm_movemask_epi8(_mm_cmpeq_epi8(
+					_mm_load_si128((const __m128i *)p), v));
+		if (n < 16)
+			m &= (1ULL << n) - 1;
+		if (m)
+			return ((void *)(p + __builtin_ctzll(m)));
+		if (n <= 16)
+			break ;
+		p += 16;
+		n -= 16;
+	}
+	return (NULL);
+}
+
+/*
+ * Function: _lv_memchr_avx2
+ * -------------------------
+ * AVX2 variant of `lv_memchr`. Same structure as `_lv_memchr_sse2`,
+ * with 32-byte blocks; the unrolled step ORs four compares together and
+ * only splits them up once something matched.
+ */
+
+LV_AVX2 void	*_lv_memchr_avx2(const void *ptr, int c, size_t n)
+{
+	const t_u8	*p;
+	__m256i		v;
+	__m256i		r[4];
+	t_u64		m;
+	size_t		off;
+
+	v = _mm256_set1_epi8((char)c);
+	off = (t_uptr)ptr & 31;
+	p = (const t_u8 *)ptr - off;
+	m = (t_u32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(
+				_mm256_load_si256((const __m256i *)p), v)) >> off;
+	if (n < 32 - off)
+		m &= (1ULL << n) - 1;
+	if (m)
+		return ((void *)((const t_u8 *)ptr + __builtin_ctzll(m)));
+	if (n <= 32 - off)
+		return (NULL);
+	n -= 32 - off;
+	p += 32;
+	while (n >= 128)
+	{
+		r[0] = _mm256_cmpeq_epi8(_mm256_load_si256((const __m256i *)p), v);
+		r[1] = _mm256_cmpeq_epi8(
+				_mm256_load_si256((const __m256i *)(p + 32)), v);
+		r[2] = _mm256_cmpeq_epi8(
+				_mm256_load_si256((const __m256i *)(p + 64)), v);
+		r[3] = _mm256_cmpeq_epi8(
+				_mm256_load_si256((const __m256i *)(p + 96)), v);
+		if (_mm256_movemask_epi8(_mm256_or_si256(
+					_mm256_or_si256(r[0], r[1]), _mm256_or_si256(r[2], r[3]))))
+		{
+			m = (t_u32)_mm256_movemask_epi8(r[0])
+				| (t_u64)(t_u32)_mm256_movemask_epi8(r[1]) << 32;
+			if (m)
+				return ((void *)(p + __builtin_ctzll(m)));
+			m = (t_u32)_mm256_movemask_epi8(r[2])
+				| (t_u64)(t_u32)_mm256_movemask_epi8(r[3]) << 32;
+			return ((void *)(p + 64 + __builtin_ctzll(m)));
+		}
+		p += 128;
+		n -= 128;
+	}
+	while (n)
+	{
+		m = (t_u32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(
+					_mm256_load_si256((const __m256i *)p), v));
+		if (n < 32)
+			m &= (1ULL << n) - 1;
+		if (m)
+			return ((void *)(p + __builtin_ctzll(m)));
+		if (n <= 32)
+			break ;
+		p += 32;
+		n -= 32;
+	}
+	return (NULL);
+}
+
+/*
+ * Function: _lv_memchr_avx512
+ * ---------------------------
+ * AVX-512 variant of `lv_memchr`. Same structure as `_lv_memchr_sse2`,
+ * with 64-byte blocks and the compare results taken straight from
+ * `vpcmpeqb` mask registers.
+ */
+
+LV_AVX512 void	*_lv_memchr_avx512(const void *ptr, int c, size_t n)
+{
+	const t_u8	*p;
+	__m512i		v;
+	t_u64		m[4];
+	size_t		off;
+
+	v = _mm512_set1_epi8((char)c);
+	off = (t_uptr)ptr & 63;
+	p = (const t_u8 *)ptr - off;
+	m[0] = _mm512_cmpeq_epi8_mask(_mm512_load_si512(p), v) >> off;
+	if (n < 64 - off)
+		m[0] &= (1ULL << n) - 1;
+	if (m[0])
+		return ((void *)((const t_u8 *)ptr + __builtin_ctzll(m[0])));
+	if (n <= 64 - off)
+		return (NULL);
+	n -= 64 - off;
+	p += 64;
+	while (n >= 256)
+	{
+		m[0] = _mm512_cmpeq_epi8_mask(_mm512_load_si512(p), v);
+		m[1] = _mm512_cmpeq_epi8_mask(_mm512_load_si512(p + 64), v);
+		m[2] = _mm512_cmpeq_epi8_mask(_mm512_load_si512(p + 128), v);
+		m[3] = _mm512_cmpeq_epi8_mask(_mm512_load_si512(p + 192), v);
+		if (m[0] | m[1] | m[2] | m[3])
+		{
+			off = 0;
+			while (!m[off])
+				off++;
+			return ((void *)(p + off * 64 + __builtin_ctzll(m[off])));
+		}
+		p += 256;
+		n -= 256;
+	}
+	while (n)
+	{
+		m[0] = _mm512_cmpeq_epi8_mask(_mm512_load_si512(p), v);
+		if (n < 64)
+			m[0] &= (1ULL << n) - 1;
+		if (m[0])
+			return ((void *)(p + __builtin_ctzll(m[0])));
+		if (n <= 64)
+			break ;
+		p += 64;
+		n -= 64;
+	}
+	return (NULL);
+}
+
 /*
  * Function: lv_memchr
  * -------------------
  * Scans the initial `n` bytes of the memory area pointed to by `ptr`
- * for the first occurrence of the character `c`. The search is performed
- * byte by byte.
+ * for the first occurrence of the character `c`.
  *
  * Parameters:
  * ptr - A pointer to the memory area to be searched.
@@ -35,20 +230,18 @@
  * Returns:
  * A pointer to the matching byte, or NULL if the character `c` does not
  * occur in the first `n` bytes of the memory area.
+ *
+ * Notes:
+ * - The scan is done by the SSE2, AVX2 or AVX-512 variant picked at
+ * load time by `lv_cpu_dispatch`.
+ * - Only aligned blocks are loaded, so the scan may touch bytes just
+ * before `ptr` or after `ptr + n` in the same block, but never a page
+ * the range does not already touch.
  */
 
 void	*lv_memchr(const void *__restrict__ ptr, int c, size_t n)
 {
-	unsigned int	i;
-	t_u8			*p;
-
-	p = (t_u8 *)ptr;
-	i = 0;
-	while (i < n)
-	{
-		if (p[i] == (t_u8)c)
-			return (p + i);
-		i++;
-	}
-	return ((void *) 0);
+	if (!ptr || !n)
+		return (NULL);
+	return (g_lv_mem.chr(ptr, c, n));
 }
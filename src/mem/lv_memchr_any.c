@@ -0,0 +1,358 @@
+/**
+ * lv_memchr_any.c
+ *
+ * Copyright (C) 2025 lvzrr <lvzrr@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General
+ * Public License along with this program. If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#include "mem.h"
+
+/*
+ * Function: lv_byteset_init
+ * -------------------------
+ * Builds the lookup tables used by the `lv_memchr_any` family from a list
+ * of bytes.
+ *
+ * Parameters:
+ * set   - The set to fill. Its previous contents are discarded.
+ * chars - The bytes that belong to the set.
+ * n     - The number of bytes in `chars` (a `'\0'` in it is a member
+ * like any other).
+ *
+ * Returns:
+ * None.
+ *
+ * Notes:
+ * - `bits` is a 256-bit membership bitmap for the scalar paths.
+ * - `lo` holds the nibble tables of the SIMD classifier: byte `b`, with
+ * high nibble `h` and low nibble `l`, is a member iff bit `h & 7` of
+ * `lo[h >> 3][l]` is set. The matching high-nibble tables are constant.
+ * - Build the set once and reuse it; it only depends on `chars`.
+ */
+
+void	lv_byteset_init(t_byteset *set, const void *chars, size_t n)
+{
+	const t_u8	*c;
+	t_u8		h;
+
+	if (!set)
+		return ;
+	lv_bzero(set, sizeof(*set));
+	c = (const t_u8 *)chars;
+	while (c && n--)
+	{
+		set->bits[*c >> 6] |= 1ULL << (*c & 63);
+		h = *c >> 4;
+		set->lo[h >> 3][*c & 15] |= (t_u8)(1U << (h & 7));
+		c++;
+	}
+}
+
+/*
+ * Function: _scan_scalar
+ * ----------------------
+ * Byte-at-a-time scan against the bitmap, in the direction and polarity
+ * given by `mode`. Used for short tails and by the SSE2 variant.
+ */
+
+LV_INLINE static inline void	*_scan_scalar(const t_u8 *p, size_t n,
+	const t_byteset *set, int mode)
+{
+	t_u64	want;
+	size_t	i;
+
+	want = !(mode & LV_SET_NOT);
+	if (mode & LV_SET_REV)
+	{
+		while (n--)
+			if (LV_BYTESET_HAS(set, p[n]) == want)
+				return ((void *)(p + n));
+		return (NULL);
+	}
+	i = 0;
+	while (i < n)
+	{
+		if (LV_BYTESET_HAS(set, p[i]) == want)
+			return ((void *)(p + i));
+		i++;
+	}
+	return (NULL);
+}
+
+/*
+ * Function: _lv_memchr_any_sse2
+ * -----------------------------
+ * Baseline variant of the `lv_memchr_any` family. SSE2 has no byte
+ * shuffle to drive a nibble table, so this one walks the bitmap one
+ * byte at a time; it is still a single pass, whatever the set size.
+ *
+ * Parameters:
+ * ptr  - A pointer to the memory area to be searched.
+ * n    - The number of bytes to search.
+ * set  - The set built by `lv_byteset_init`.
+ * mode - `LV_SET_NOT` to look for bytes outside the set, `LV_SET_REV`
+ * to return the last match instead of the first.
+ *
+ * Returns:
+ * A pointer to the matching byte, or NULL if there is none.
+ */
+
+LV_SSE2 void	*_lv_memchr_any_sse2(const void *ptr, size_t n,
+	const t_byteset *set, int mode)
+{
+	return (_scan_scalar((const t_u8 *)ptr, n, set, mode));
+}
+
+/*
+ * Function: _class_avx2
+ * ---------------------
+ * Classifies 32 bytes at once: looks up both nibbles of every byte with
+ * `vpshufb` and returns a bit mask of the bytes that are in the set.
+ * Two table pairs are used (high nibble 0-7 and 8-15), so the result is
+ * exact for any set.
+ */
+
+LV_AVX2 LV_INLINE static inline t_u32	_class_avx2(__m256i x,
+	const __m256i *t)
+{
+	__m256i	lo;
+	__m256i	hi;
+	__m256i	r;
+
+	lo = _mm256_and_si256(x, _mm256_set1_epi8(0x0F));
+	hi = _mm256_and_si256(_mm256_srli_epi16(x, 4), _mm256_set1_epi8(0x0F));
+	r = _mm256_or_si256(
+			_mm256_and_si256(_mm256_shuffle_epi8(t[0], lo),
+				_mm256_shuffle_epi8(t[2], hi)),
+			_mm256_and_si256(_mm256_shuffle_epi8(t[1], lo),
+				_mm256_shuffle_epi8(t[3], hi)));
+	return (~(t_u32)_mm256_movemask_epi8(
+			_mm256_cmpeq_epi8(r, _mm256_setzero_si256())));
+}
+
+/*
+ * Function: _lv_memchr_any_avx2
+ * -----------------------------
+ * AVX2 variant of the `lv_memchr_any` family. Classifies 32 unaligned
+ * bytes per step with `_class_avx2`, flips the mask for `LV_SET_NOT`, and
+ * takes ctz (forwards) or clz (backwards) on a hit. Fewer than 32
+ * remaining bytes are finished on the bitmap.
+ */
+
+LV_AVX2 void	*_lv_memchr_any_avx2(const void *ptr, size_t n,
+	const t_byteset *set, int mode)
+{
+	const t_u8	*p;
+	__m256i		t[4];
+	t_u32		flip;
+	t_u32		m;
+
+	p = (const t_u8 *)ptr;
+	flip = (mode & LV_SET_NOT) ? 0xFFFFFFFFU : 0;
+	t[0] = _mm256_broadcastsi128_si256(
+			_mm_load_si128((const __m128i *)set->lo[0]));
+	t[1] = _mm256_broadcastsi128_si256(
+			_mm_load_si128((const __m128i *)set->lo[1]));
+	t[2] = _mm256_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0,
+			0, 0, 1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0);
+	t[3] = _mm256_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 4, 8, 16, 32, 64,
+			-128, 0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 4, 8, 16, 32, 64, -128);
+	if (!(mode & LV_SET_REV))
+	{
+		while (n >= 32)
+		{
+			m = _class_avx2(_mm256_loadu_si256((const __m256i *)p), t) ^ flip;
+			if (m)
+				return ((void *)(p + __builtin_ctz(m)));
+			p += 32;
+			n -= 32;
+		}
+		return (_scan_scalar(p, n, set, mode));
+	}
+	while (n >= 32)
+	{
+		m = _class_avx2(_mm256_loadu_si256(
+					(const __m256i *)(p + n - 32)), t) ^ flip;
+		if (m)
+			return ((void *)(p + n - 1 - __builtin_clz(m)));
+		n -= 32;
+	}
+	return (_scan_scalar(p, n, set, mode));
+}
+
+/*
+ * Function: _class_avx512
+ * -----------------------
+ * AVX-512 version of `_class_avx2`, 64 bytes at a time, returning the
+ * membership mask straight from `vptestmb`.
+ */
+
+LV_AVX512 LV_INLINE static inline t_u64	_class_avx512(__m512i x,
+	const __m512i *t)
+{
+	__m512i	lo;
+	__m512i	hi;
+
+	lo = _mm512_and_si512(x, _mm512_set1_epi8(0x0F));
+	hi = _mm512_and_si512(_mm512_srli_epi16(x, 4), _mm512_set1_epi8(0x0F));
+	return (_mm512_test_epi8_mask(
+			_mm512_or_si512(
+				_mm512_and_si512(_mm512_shuffle_epi8(t[0], lo),
+					_mm512_shuffle_epi8(t[2], hi)),
+				_mm512_and_si512(_mm512_shuffle_epi8(t[1], lo),
+					_mm512_shuffle_epi8(t[3], hi))),
+			_mm512_set1_epi8(-1)));
+}
+
+/*
+ * Function: _lv_memchr_any_avx512
+ * -------------------------------
+ * AVX-512 variant of the `lv_memchr_any` family. Same as the AVX2 one
+ * with 64-byte steps; the last partial block is read with a byte-masked
+ * load, so there is no scalar tail.
+ */
+
+LV_AVX512 void	*_lv_memchr_any_avx512(const void *ptr, size_t n,
+	const t_byteset *set, int mode)
+{
+	const t_u8	*p;
+	const t_u8	*q;
+	__m512i		t[4];
+	t_u64		flip;
+	t_u64		m;
+	__mmask64	k;
+	size_t		w;
+
+	p = (const t_u8 *)ptr;
+	flip = (mode & LV_SET_NOT) ? ~0ULL : 0;
+	t[0] = _mm512_broadcast_i32x4(_mm_load_si128((const __m128i *)set->lo[0]));
+	t[1] = _mm512_broadcast_i32x4(_mm_load_si128((const __m128i *)set->lo[1]));
+	t[2] = _mm512_broadcast_i32x4(_mm_setr_epi8(1, 2, 4, 8, 16, 32, 64,
+				-128, 0, 0, 0, 0, 0, 0, 0, 0));
+	t[3] = _mm512_broadcast_i32x4(_mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1,
+				2, 4, 8, 16, 32, 64, -128));
+	while (n)
+	{
+		w = (n < 64) ? n : 64;
+		k = (w < 64) ? (1ULL << w) - 1 : ~0ULL;
+		q = (mode & LV_SET_REV) ? p + n - w : p;
+		m = (_class_avx512(_mm512_maskz_loadu_epi8(k, q), t) ^ flip) & k;
+		if (m && (mode & LV_SET_REV))
+			return ((void *)(q + 63 - __builtin_clzll(m)));
+		if (m)
+			return ((void *)(q + __builtin_ctzll(m)));
+		if (!(mode & LV_SET_REV))
+			p += w;
+		n -= w;
+	}
+	return (NULL);
+}
+
+/*
+ * Function: lv_memchr_any
+ * -----------------------
+ * Finds the first byte of `ptr[0..n)` that belongs to `set`, in one pass
+ * whatever the size of the set (the multi-byte `memchr`, or `strpbrk`
+ * with an explicit length).
+ *
+ * Parameters:
+ * ptr - A pointer to the memory area to be searched.
+ * n   - The number of bytes to search.
+ * set - A set built by `lv_byteset_init`.
+ *
+ * Returns:
+ * A pointer to the matching byte, or NULL if there is none (or if `ptr`
+ * or `set` is NULL).
+ *
+ * Notes:
+ * - The scan is done by the variant picked at load time by
+ * `lv_cpu_dispatch`: a `vpshufb` nibble-table classifier on AVX2 and
+ * AVX-512, the bitmap otherwise.
+ */
+
+void	*lv_memchr_any(const void *ptr, size_t n, const t_byteset *set)
+{
+	if (!ptr || !n || !set)
+		return (NULL);
+	return (g_lv_mem.any(ptr, n, set, 0));
+}
+
+/*
+ * Function: lv_memchr_not
+ * -----------------------
+ * Finds the first byte of `ptr[0..n)` that does not belong to `set`
+ * (`strspn` with an explicit length, e.g. to skip leading delimiters).
+ *
+ * Parameters:
+ * ptr - A pointer to the memory area to be searched.
+ * n   - The number of bytes to search.
+ * set - A set built by `lv_byteset_init`.
+ *
+ * Returns:
+ * A pointer to the first byte outside the set, or NULL if every byte is
+ * in it.
+ */
+
+void	*lv_memchr_not(const void *ptr, size_t n, const t_byteset *set)
+{
+	if (!ptr || !n || !set)
+		return (NULL);
+	return (g_lv_mem.any(ptr, n, set, LV_SET_NOT));
+}
+
+/*
+ * Function: lv_memrchr_any
+ * ------------------------
+ * Finds the last byte of `ptr[0..n)` that belongs to `set`.
+ *
+ * Parameters:
+ * ptr - A pointer to the memory area to be searched.
+ * n   - The number of bytes to search.
+ * set - A set built by `lv_byteset_init`.
+ *
+ * Returns:
+ * A pointer to the matching byte, or NULL if there is none.
+ */
+
+void	*lv_memrchr_any(const void *ptr, size_t n, const t_byteset *set)
+{
+	if (!ptr || !n || !set)
+		return (NULL);
+	return (g_lv_mem.any(ptr, n, set, LV_SET_REV));
+}
+
+/*
+ * Function: lv_memrchr_not
+ * ------------------------
+ * Finds the last byte of `ptr[0..n)` that does not belong to `set`
+ * (e.g. the end of a string once trailing delimiters are trimmed).
+ *
+ * Parameters:
+ * ptr - A pointer to the memory area to be searched.
+ * n   - The number of bytes to search.
+ * set - A set built by `lv_byteset_init`.
+ *
+ * Returns:
+ * A pointer to the last byte outside the set, or NULL if every byte is
+ * in it.
+ */
+
+void	*lv_memrchr_not(const void *ptr, size_t n, const t_byteset *set)
+{
+	if (!ptr || !n || !set)
+		return (NULL);
+	return (g_lv_mem.any(ptr, n, set, LV_SET_NOT | LV_SET_REV));
+}
@@ -21,55 +21,237 @@
 #include "mem.h"
 
 /*
- * Function: _alinger
- * ------------------
- * Helper function for `lv_memcmp` to handle initial unaligned bytes
- * and attempt to align the pointers for more efficient word-sized comparisons.
- * It compares bytes two at a time until alignment is achieved or a difference is found.
+ * Function: _cmp_small
+ * --------------------
+ * Compares fewer than 16 bytes with two overlapping 8- or 4-byte loads
+ * per side instead of a byte loop. The first differing byte is found
+ * from the XOR of the two words with ctz.
+ */
+
+LV_INLINE static inline ssize_t	_cmp_small(const t_u8 *a, const t_u8 *b,
+	size_t n)
+{
+	t_u64	x;
+	size_t	k;
+
+	if (n >= 4)
+	{
+		k = (n >= 8) ? 8 : 4;
+		if (k == 8)
+			x = *(const t_u64u *)a ^ *(const t_u64u *)b;
+		else
+			x = *(const t_u32u *)a ^ *(const t_u32u *)b;
+		if (!x)
+		{
+			a += n - k;
+			b += n - k;
+			if (k == 8)
+				x = *(const t_u64u *)a ^ *(const t_u64u *)b;
+			else
+				x = *(const t_u32u *)a ^ *(const t_u32u *)b;
+			if (!x)
+				return (0);
+		}
+		k = (size_t)__builtin_ctzll(x) >> 3;
+		return ((ssize_t)a[k] - (ssize_t)b[k]);
+	}
+	while (n--)
+	{
+		if (*a != *b)
+			return ((ssize_t)*a - (ssize_t)*b);
+		++a;
+		++b;
+	}
+	return (0);
+}
+
+/*
+ * Function: _lv_memcmp_sse2
+ * -------------------------
+ * SSE2 variant of `lv_memcmp`. Compares 64 bytes per step with unaligned
+ * loads, `pcmpeqb` and `pmovmskb`, packing the four 16-bit masks into one
+ * word so a single ctz on its complement gives the first differing byte.
+ * The remainder is handled with whole blocks and one final block that
+ * overlaps the previous one, so no byte loop runs for `n >= 16`.
  *
  * Parameters:
- * dest - A pointer to the first memory region.
- * src  - A pointer to the second memory region.
- * n    - A pointer to the remaining number of bytes to compare. This value is decremented.
- * r    - A pointer to a `t_u8` that will store the alignment status from `_aligned`.
- * i    - A pointer to the current index within the buffers. This value is incremented.
+ * dest - A pointer to the first memory area.
+ * src  - A pointer to the second memory area.
+ * n    - The number of bytes to compare.
  *
  * Returns:
- * The difference between the first differing bytes, or 0 if no difference is found
- * within the handled unaligned section. A negative value if `dest` byte is less
- * than `src` byte, positive if greater.
- *
- * Notes:
- * - This function is `always_inline` for performance critical paths.
- * - It updates `n` and `i` to reflect the bytes processed.
- * - `*r` is set by calls to `_aligned` to indicate if alignment has been achieved.
+ * The difference between the first pair of differing bytes (as
+ * `unsigned char`), or 0 if the areas are equal.
+ */
+
+LV_SSE2 ssize_t	_lv_memcmp_sse2(const void *dest, const void *src, size_t n)
+{
+	const t_u8	*a;
+	const t_u8	*b;
+	t_u64		m;
+
+	a = (const t_u8 *)dest;
+	b = (const t_u8 *)src;
+	if (n < 16)
+		return (_cmp_small(a, b, n));
+	while (n >= 64)
+	{
+		m = (t_u64)(t_u32)_mm_movemask_epi8(_mm_cmpeq_epi8(
+					_mm_loadu_si128((const __m128i *)a),
+					_mm_loadu_si128((const __m128i *)b)))
+			| (t_u64)(t_u32)_mm_movemask_epi8(_mm_cmpeq_epi8(
+					_mm_loadu_si128((const __m128i *)(a + 16)),
+					_mm_loadu_si128((const __m128i *)(b + 16)))) << 16
+			| (t_u64)(t_u32)_mm_movemask_epi8(_mm_cmpeq_epi8(
+					_mm_loadu_si128((const __m128i *)(a + 32)),
+					_mm_loadu_si128((const __m128i *)(b + 32)))) << 32
+			| (t_u64)(t_u32)_mm_movemask_epi8(_mm_cmpeq_epi8(
+					_mm_loadu_si128((const __m128i *)(a + 48)),
+					_mm_loadu_si128((const __m128i *)(b + 48)))) << 48;
+		m = ~m;
+		if (m)
+		{
+			m = (t_u64)__builtin_ctzll(m);
+			return ((ssize_t)a[m] - (ssize_t)b[m]);
+		}
+		a += 64;
+		b += 64;
+		n -= 64;
+	}
+	while (n)
+	{
+		if (n < 16)
+		{
+			a -= 16 - n;
+			b -= 16 - n;
+			n = 16;
+		}
+		m = ~(t_u64)(t_u32)_mm_movemask_epi8(_mm_cmpeq_epi8(
+					_mm_loadu_si128((const __m128i *)a),
+					_mm_loadu_si128((const __m128i *)b))) & 0xFFFF;
+		if (m)
+		{
+			m = (t_u64)__builtin_ctzll(m);
+			return ((ssize_t)a[m] - (ssize_t)b[m]);
+		}
+		a += 16;
+		b += 16;
+		n -= 16;
+	}
+	return (0);
+}
+
+/*
+ * Function: _lv_memcmp_avx2
+ * -------------------------
+ * AVX2 variant of `lv_memcmp`. Same structure as `_lv_memcmp_sse2`, with
+ * 32-byte blocks: the four compares of a 128-byte step are ANDed and only
+ * split up when something differs. Inputs shorter than 32 bytes use two
+ * overlapping 16-byte compares.
+ */
+
+LV_AVX2 ssize_t	_lv_memcmp_avx2(const void *dest, const void *src, size_t n)
+{
+	const t_u8	*a;
+	const t_u8	*b;
+	__m256i		r[4];
+	t_u64		m;
+
+	a = (const t_u8 *)dest;
+	b = (const t_u8 *)src;
+	if (n < 32)
+		return (_lv_memcmp_sse2(a, b, n));
+	while (n >= 128)
+	{
+		r[0] = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)a),
+				_mm256_loadu_si256((const __m256i *)b));
+		r[1] = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(a + 32)),
+				_mm256_loadu_si256((const __m256i *)(b + 32)));
+		r[2] = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(a + 64)),
+				_mm256_loadu_si256((const __m256i *)(b + 64)));
+		r[3] = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(a + 96)),
+				_mm256_loadu_si256((const __m256i *)(b + 96)));
+		if ((t_u32)_mm256_movemask_epi8(_mm256_and_si256(
+					_mm256_and_si256(r[0], r[1]),
+					_mm256_and_si256(r[2], r[3]))) != 0xFFFFFFFFU)
+			break ;
+		a += 128;
+		b += 128;
+		n -= 128;
+	}
+	while (n)
+	{
+		if (n < 32)
+		{
+			a -= 32 - n;
+			b -= 32 - n;
+			n = 32;
+		}
+		m = ~(t_u32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(
+					_mm256_loadu_si256((const __m256i *)a),
+					_mm256_loadu_si256((const __m256i *)b))) & 0xFFFFFFFFU;
+		if (m)
+		{
+			m = (t_u64)__builtin_ctzll(m);
+			return ((ssize_t)a[m] - (ssize_t)b[m]);
+		}
+		a += 32;
+		b += 32;
+		n -= 32;
+	}
+	return (0);
+}
+
+/*
+ * Function: _lv_memcmp_avx512
+ * ---------------------------
+ * AVX-512 variant of `lv_memcmp`. Compares 64-byte blocks with
+ * `vpcmpneqb` straight into a mask register. The tail (and any input
+ * shorter than 64 bytes) is read with a byte-masked load, which never
+ * touches memory outside the range, so there is no scalar path at all.
  */
 
-LV_INLINE inline ssize_t    _alinger(void *__restrict__ dest,
-	const void *__restrict__ src, size_t *n, t_u8 *r,
-	size_t *__restrict__ i)
+LV_AVX512 ssize_t	_lv_memcmp_avx512(const void *dest, const void *src,
+	size_t n)
 {
-	while (*n >= 2 && !*r)
+	const t_u8	*a;
+	const t_u8	*b;
+	t_u64		m;
+	__mmask64	k;
+
+	a = (const t_u8 *)dest;
+	b = (const t_u8 *)src;
+	while (n >= 256)
 	{
-		if(((t_u8 *)dest + *i)[0] != ((t_u8 *)src + *i)[0])
-			return (((t_u8 *)dest + *i)[0] - ((t_u8 *)src + *i)[0]);
-		*i += sizeof(t_u8);
-		*n -= sizeof(t_u8);
-		*r = _aligned((t_u8 *)dest, (t_u8 *)src, i);
-		if (r)
-			return (0);
-		if(((t_u8 *)dest + *i)[0] != ((t_u8 *)src + *i)[0])
-			return (((t_u8 *)dest + *i)[0] - ((t_u8 *)src + *i)[0]);
-		*i += sizeof(t_u8);
-		*n -= sizeof(t_u8);
-		*r = _aligned((t_u8 *)dest, (t_u8 *)src, i);
+		m = _mm512_cmpneq_epi8_mask(_mm512_loadu_si512(a),
+				_mm512_loadu_si512(b))
+			| _mm512_cmpneq_epi8_mask(_mm512_loadu_si512(a + 64),
+				_mm512_loadu_si512(b + 64))
+			| _mm512_cmpneq_epi8_mask(_mm512_loadu_si512(a + 128),
+				_mm512_loadu_si512(b + 128))
+			| _mm512_cmpneq_epi8_mask(_mm512_loadu_si512(a + 192),
+				_mm512_loadu_si512(b + 192));
+		if (m)
+			break ;
+		a += 256;
+		b += 256;
+		n -= 256;
 	}
-	if (*n >= 1 && !*r) {
-		if(((t_u8 *)dest + *i)[0] != ((t_u8 *)src + *i)[0])
-			return (((t_u8 *)dest + *i)[0] - ((t_u8 *)src + *i)[0]);
-		*i += sizeof(t_u8);
-		*n -= sizeof(t_u8);
-		*r = _aligned((t_u8 *)dest, (t_u8 *)src, i);
+	while (n)
+	{
+		k = (n < 64) ? (1ULL << n) - 1 : ~0ULL;
+		m = _mm512_cmpneq_epi8_mask(_mm512_maskz_loadu_epi8(k, a),
+				_mm512_maskz_loadu_epi8(k, b));
+		if (m)
+		{
+			m = (t_u64)__builtin_ctzll(m);
+			return ((ssize_t)a[m] - (ssize_t)b[m]);
+		}
+		if (n <= 64)
+			break ;
+		a += 64;
+		b += 64;
+		n -= 64;
 	}
 	return (0);
 }
@@ -91,39 +273,19 @@ LV_INLINE inline ssize_t    _alinger(void *__restrict__ dest,
  * or be greater than the first `n` bytes of `src`.
  *
  * Notes:
- * - This function is optimized to handle unaligned memory access initially,
- * then transitions to word-sized comparisons (32-bit, 64-bit, 128-bit)
- * if the pointers become aligned, and finally falls back to byte-wise
- * comparison for any remaining bytes.
- * - It uses helper functions `_alinger`, `_cmp_u8`, `_cmp_u32`, `_cmp_u64`,
- * and `_cmp_u128` for efficient comparison.
+ * - The comparison is done by the SSE2, AVX2 or AVX-512 variant picked
+ * at load time by `lv_cpu_dispatch`. All of them use unaligned loads
+ * and locate the first difference with ctz on the compare mask.
+ * - If exactly one of `dest` and `src` is NULL, it returns -1.
+ * - Use `lv_memeq` when only equality matters.
  */
 
 ssize_t	lv_memcmp(void *__restrict__ dest,
 	const void *__restrict__ src, size_t n)
 {
-	size_t	i;
-	t_u8	r;
-	ssize_t	r2;
-	ssize_t	r3;
-
 	if ((!dest && !src) || n == 0 || dest == src)
 		return (0);
 	if ((!dest && src) || (!src && dest))
 		return (-1);
-	i = 0;
-	r = _aligned((t_u8 *)dest, (t_u8 *)src, &i);
-	r3 = 0;
-	r2 = _alinger(dest, src, &n, &r, &i);
-	if (r2 < 0)
-		return (r2);
-	if (n >= sizeof(t_u128) * 2 && r == 128)
-		r3 = _cmp_u128((t_u8 *)dest, (t_u8 *)src, &n, &i);
-	else if (n >= sizeof(t_u64) * 2 && r >= 64)
-		r3 = _cmp_u64((t_u8 *)dest, (t_u8 *)src, &n, &i);
-	else if (n >= sizeof(t_u32) * 2 && r >= 32)
-		r3 = _cmp_u32((t_u8 *)dest, (t_u8 *)src, &n, &i);
-	if (n > 0 && r3 == 0)
-		r3 = _cmp_u8((t_u8 *)dest, (t_u8 *)src, &n, &i);
-	return (r3);
+	return (g_lv_mem.cmp(dest, src, n));
 }
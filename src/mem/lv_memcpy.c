@@ -21,42 +21,163 @@
 #include "mem.h"
 
 /*
- * Function: _alinger
- * ------------------
- * Helper function for `lv_memcpy` to handle initial unaligned bytes
- * and attempt to align the pointers for more efficient word-sized copies.
- * It copies bytes two at a time until alignment is achieved.
+ * Function: _lv_memcpy_sse2
+ * -------------------------
+ * SSE2 variant of `lv_memcpy`. Copies bytes until `dest` is 16-byte
+ * aligned, then moves 64 bytes per iteration with unaligned 128-bit
+ * loads and aligned stores, whatever the alignment of `src`. The tail is
+ * copied byte by byte. Copies of `g_lv_nt_threshold` bytes or more
+ * go to `_lv_memcpy_nt_sse2` instead.
  *
  * Parameters:
- * dest - A pointer to the destination memory region.
- * src  - A pointer to the source memory region.
- * n    - A pointer to the remaining number of bytes to copy. This value is decremented.
- * r    - A pointer to a `t_u8` that will store the alignment status from `_aligned`.
+ * dest - A pointer to the destination memory area.
+ * src  - A pointer to the source memory area.
+ * n    - The number of bytes to copy.
  *
  * Returns:
- * The number of bytes processed by this function to achieve alignment or exhaust `n`.
- *
- * Notes:
- * - This function is `always_inline` for performance critical paths.
- * - It updates `n` to reflect the bytes processed.
- * - `*r` is set by calls to `_aligned` to indicate if alignment has been achieved.
+ * A pointer to the destination memory area `dest`.
+ */
+
+LV_SSE2 void	*_lv_memcpy_sse2(void *__restrict__ dest,
+	const void *__restrict__ src, size_t n)
+{
+	t_u8		*d;
+	const t_u8	*s;
+
+	if (n >= g_lv_nt_threshold)
+		return (_lv_memcpy_nt_sse2(dest, src, n));
+	d = (t_u8 *)dest;
+	s = (const t_u8 *)src;
+	while (n && ((t_uptr)d & 15))
+	{
+		*d++ = *s++;
+		--n;
+	}
+	while (n >= 64)
+	{
+		_mm_store_si128((__m128i *)d, _mm_loadu_si128((const __m128i *)s));
+		_mm_store_si128((__m128i *)(d + 16),
+			_mm_loadu_si128((const __m128i *)(s + 16)));
+		_mm_store_si128((__m128i *)(d + 32),
+			_mm_loadu_si128((const __m128i *)(s + 32)));
+		_mm_store_si128((__m128i *)(d + 48),
+			_mm_loadu_si128((const __m128i *)(s + 48)));
+		d += 64;
+		s += 64;
+		n -= 64;
+	}
+	while (n >= 16)
+	{
+		_mm_store_si128((__m128i *)d, _mm_loadu_si128((const __m128i *)s));
+		d += 16;
+		s += 16;
+		n -= 16;
+	}
+	while (n)
+	{
+		*d++ = *s++;
+		--n;
+	}
+	return (dest);
+}
+
+/*
+ * Function: _lv_memcpy_avx2
+ * -------------------------
+ * AVX2 variant of `lv_memcpy`. Same structure as `_lv_memcpy_sse2`,
+ * with 32-byte alignment and 256-bit registers (128 bytes per iteration).
+ */
+
+LV_AVX2 void	*_lv_memcpy_avx2(void *__restrict__ dest,
+	const void *__restrict__ src, size_t n)
+{
+	t_u8		*d;
+	const t_u8	*s;
+
+	if (n >= g_lv_nt_threshold)
+		return (_lv_memcpy_nt_avx2(dest, src, n));
+	d = (t_u8 *)dest;
+	s = (const t_u8 *)src;
+	while (n && ((t_uptr)d & 31))
+	{
+		*d++ = *s++;
+		--n;
+	}
+	while (n >= 128)
+	{
+		_mm256_store_si256((__m256i *)d,
+			_mm256_loadu_si256((const __m256i *)s));
+		_mm256_store_si256((__m256i *)(d + 32),
+			_mm256_loadu_si256((const __m256i *)(s + 32)));
+		_mm256_store_si256((__m256i *)(d + 64),
+			_mm256_loadu_si256((const __m256i *)(s + 64)));
+		_mm256_store_si256((__m256i *)(d + 96),
+			_mm256_loadu_si256((const __m256i *)(s + 96)));
+		d += 128;
+		s += 128;
+		n -= 128;
+	}
+	while (n >= 32)
+	{
+		_mm256_store_si256((__m256i *)d,
+			_mm256_loadu_si256((const __m256i *)s));
+		d += 32;
+		s += 32;
+		n -= 32;
+	}
+	while (n)
+	{
+		*d++ = *s++;
+		--n;
+	}
+	return (dest);
+}
+
+/*
+ * Function: _lv_memcpy_avx512
+ * ---------------------------
+ * AVX-512 variant of `lv_memcpy`. Same structure as `_lv_memcpy_sse2`,
+ * with 64-byte alignment and 512-bit registers (256 bytes per iteration).
  */
 
-LV_INLINE inline size_t	_alinger(void *__restrict__ dest,
-	const void *__restrict__ src, size_t *n, t_u8 *r)
+LV_AVX512 void	*_lv_memcpy_avx512(void *__restrict__ dest,
+	const void *__restrict__ src, size_t n)
 {
-	size_t	x;
+	t_u8		*d;
+	const t_u8	*s;
 
-	x = 0;
-	*r = _aligned((t_u8 *)dest, (t_u8 *)src, &x);
-	while (*n && !*r)
+	if (n >= g_lv_nt_threshold)
+		return (_lv_memcpy_nt_avx512(dest, src, n));
+	d = (t_u8 *)dest;
+	s = (const t_u8 *)src;
+	while (n && ((t_uptr)d & 63))
+	{
+		*d++ = *s++;
+		--n;
+	}
+	while (n >= 256)
 	{
-		((t_u8 *)dest)[x] = ((t_u8 *)src)[x];
-		++x;
-		--(*n);
-		*r = _aligned((t_u8 *)dest, (t_u8 *)src, &x);
+		_mm512_store_si512(d, _mm512_loadu_si512(s));
+		_mm512_store_si512(d + 64, _mm512_loadu_si512(s + 64));
+		_mm512_store_si512(d + 128, _mm512_loadu_si512(s + 128));
+		_mm512_store_si512(d + 192, _mm512_loadu_si512(s + 192));
+		d += 256;
+		s += 256;
+		n -= 256;
 	}
-	return (x);
+	while (n >= 64)
+	{
+		_mm512_store_si512(d, _mm512_loadu_si512(s));
+		d += 64;
+		s += 64;
+		n -= 64;
+	}
+	while (n)
+	{
+		*d++ = *s++;
+		--n;
+	}
+	return (dest);
 }
 
 /*
@@ -75,32 +196,22 @@ LV_INLINE inline size_t	_alinger(void *__restrict__ dest,
  *
  * Notes:
  * - This function is marked `hot` indicating it's expected to be called frequently.
- * - It's optimized to handle initial unaligned bytes and then switch to
- * word-sized copies (32-bit, 64-bit, 128-bit) if alignment is achieved,
- * falling back to byte-wise copy for any remaining bytes.
- * - It uses helper functions `_alinger`, `_copy_u8_fwd`, `_copy_u32_fwd`,
- * `_copy_u64_fwd`, and `_copy_u128_fwd` for efficient copying.
+ * - The copy itself is done by the SSE2, AVX2 or AVX-512 variant picked
+ * at load time by `lv_cpu_dispatch`, so one build runs at full width on
+ * every x86-64 CPU without needing `-march=native`.
+ * - Copies larger than `g_lv_nt_threshold` (3/4 of the last level cache)
+ * use non-temporal stores so they do not flush the cache; see
+ * `lv_memcpy_nt` to force that path.
+ * - Copies of up to `LV_SMALL_COPY` bytes skip the table and use the
+ * branch-light `_lv_memcpy_small` kernel.
  */
 
-LV_SIMD LV_INLINE_HOT inline void	*lv_memcpy(void *__restrict__ dest,
+LV_HOT void	*lv_memcpy(void *__restrict__ dest,
 	const void *__restrict__ src, size_t n)
 {
-	void	*ret;
-	size_t	i;
-	t_u8	r;
-
 	if ((!dest || !src || dest == src) && n != 0)
 		return (NULL);
-	r = 0;
-	ret = dest;
-	i = _alinger(dest, src, &n, &r);
-	if (n >= sizeof(t_u128) * 2 && r == 128)
-		_copy_u128_fwd((t_u8 *)dest, (t_u8 *)src, &n, &i);
-	else if (n >= sizeof(t_u64) * 2 && r >= 64)
-		_copy_u64_fwd((t_u8 *)dest, (t_u8 *)src, &n, &i);
-	else if (n >= sizeof(t_u32) * 2 && r >= 32)
-		_copy_u32_fwd((t_u8 *)dest, (t_u8 *)src, &n, &i);
-	if (n > 0)
-		_copy_u8_fwd((t_u8 *)dest, (t_u8 *)src, &n, &i);
-	return (ret);
+	if (n <= LV_SMALL_COPY)
+		return (_lv_memcpy_small(dest, src, n));
+	return (g_lv_mem.cpy(dest, src, n));
 }
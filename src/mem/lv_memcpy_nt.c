@@ -0,0 +1,189 @@
+/**
+ * lv_memcpy_nt.c
+ *
+ * Copyright (C) 2025 lvzrr <lvzrr@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General
+ * Public License along with this program. If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#include "mem.h"
+
+/*
+ * Function: _lv_memcpy_nt_sse2
+ * ----------------------------
+ * SSE2 streaming copy. Copies bytes until `dest` is 16-byte aligned,
+ * then moves 64 bytes per iteration with unaligned loads and
+ * non-temporal `_mm_stream_si128` stores, so the destination does not
+ * displace the working set from the cache. An `sfence` orders the
+ * streamed stores before the byte tail and the return.
+ *
+ * Parameters:
+ * dest - A pointer to the destination memory area.
+ * src  - A pointer to the source memory area.
+ * n    - The number of bytes to copy.
+ *
+ * Returns:
+ * A pointer to the destination memory area `dest`.
+ */
+
+LV_SSE2 void	*_lv_memcpy_nt_sse2(void *__restrict__ dest,
+	const void *__restrict__ src, size_t n)
+{
+	t_u8		*d;
+	const t_u8	*s;
+
+	d = (t_u8 *)dest;
+	s = (const t_u8 *)src;
+	while (n && ((t_uptr)d & 15))
+	{
+		*d++ = *s++;
+		--n;
+	}
+	while (n >= 64)
+	{
+		_mm_stream_si128((__m128i *)d,
+			_mm_loadu_si128((const __m128i *)s));
+		_mm_stream_si128((__m128i *)(d + 16),
+			_mm_loadu_si128((const __m128i *)(s + 16)));
+		_mm_stream_si128((__m128i *)(d + 32),
+			_mm_loadu_si128((const __m128i *)(s + 32)));
+		_mm_stream_si128((__m128i *)(d + 48),
+			_mm_loadu_si128((const __m128i *)(s + 48)));
+		d += 64;
+		s += 64;
+		n -= 64;
+	}
+	_mm_sfence();
+	while (n)
+	{
+		*d++ = *s++;
+		--n;
+	}
+	return (dest);
+}
+
+/*
+ * Function: _lv_memcpy_nt_avx2
+ * ----------------------------
+ * AVX2 variant of `_lv_memcpy_nt_sse2`, with 32-byte alignment and
+ * `_mm256_stream_si256` (128 bytes per iteration).
+ */
+
+LV_AVX2 void	*_lv_memcpy_nt_avx2(void *__restrict__ dest,
+	const void *__restrict__ src, size_t n)
+{
+	t_u8		*d;
+	const t_u8	*s;
+
+	d = (t_u8 *)dest;
+	s = (const t_u8 *)src;
+	while (n && ((t_uptr)d & 31))
+	{
+		*d++ = *s++;
+		--n;
+	}
+	while (n >= 128)
+	{
+		_mm256_stream_si256((__m256i *)d,
+			_mm256_loadu_si256((const __m256i *)s));
+		_mm256_stream_si256((__m256i *)(d + 32),
+			_mm256_loadu_si256((const __m256i *)(s + 32)));
+		_mm256_stream_si256((__m256i *)(d + 64),
+			_mm256_loadu_si256((const __m256i *)(s + 64)));
+		_mm256_stream_si256((__m256i *)(d + 96),
+			_mm256_loadu_si256((const __m256i *)(s + 96)));
+		d += 128;
+		s += 128;
+		n -= 128;
+	}
+	_mm_sfence();
+	while (n)
+	{
+		*d++ = *s++;
+		--n;
+	}
+	return (dest);
+}
+
+/*
+ * Function: _lv_memcpy_nt_avx512
+ * ------------------------------
+ * AVX-512 variant of `_lv_memcpy_nt_sse2`, with 64-byte alignment and
+ * `_mm512_stream_si512` (256 bytes per iteration).
+ */
+
+LV_AVX512 void	*_lv_memcpy_nt_avx512(void *__restrict__ dest,
+	const void *__restrict__ src, size_t n)
+{
+	t_u8		*d;
+	const t_u8	*s;
+
+	d = (t_u8 *)dest;
+	s = (const t_u8 *)src;
+	while (n && ((t_uptr)d & 63))
+	{
+		*d++ = *s++;
+		--n;
+	}
+	while (n >= 256)
+	{
+		_mm512_stream_si512((__m512i *)d, _mm512_loadu_si512(s));
+		_mm512_stream_si512((__m512i *)(d + 64), _mm512_loadu_si512(s + 64));
+		_mm512_stream_si512((__m512i *)(d + 128),
+			_mm512_loadu_si512(s + 128));
+		_mm512_stream_si512((__m512i *)(d + 192),
+			_mm512_loadu_si512(s + 192));
+		d += 256;
+		s += 256;
+		n -= 256;
+	}
+	_mm_sfence();
+	while (n)
+	{
+		*d++ = *s++;
+		--n;
+	}
+	return (dest);
+}
+
+/*
+ * Function: lv_memcpy_nt
+ * ----------------------
+ * Copies `n` bytes from `src` to `dest` with non-temporal stores,
+ * regardless of `g_lv_nt_threshold`. Use it for data that will not be
+ * read again soon (e.g. buffers handed to I/O or another core).
+ *
+ * Parameters:
+ * dest - A pointer to the destination memory area.
+ * src  - A pointer to the source memory area.
+ * n    - The number of bytes to copy.
+ *
+ * Returns:
+ * A pointer to the destination memory area `dest`, or NULL under the
+ * same conditions as `lv_memcpy`.
+ *
+ * Notes:
+ * - The memory areas must not overlap.
+ * - For small copies streaming is slower than `lv_memcpy`, since the
+ * destination lines are not kept in the cache.
+ */
+
+void	*lv_memcpy_nt(void *__restrict__ dest,
+	const void *__restrict__ src, size_t n)
+{
+	if ((!dest || !src || dest == src) && n != 0)
+		return (NULL);
+	return (g_lv_mem.cpy_nt(dest, src, n));
+}
@@ -0,0 +1,228 @@
+/**
+ * lv_memeq.c
+ *
+ * Copyright (C) 2025 lvzrr <lvzrr@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General
+ * Public License along with this program. If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#include "mem.h"
+
+/*
+ * Function: _lv_memeq_sse2
+ * ------------------------
+ * SSE2 variant of `lv_memeq`. ORs the XOR of four unaligned 16-byte
+ * blocks per step and tests the result once, so there is no per-block
+ * branch and no work spent locating the difference. Inputs shorter than
+ * 16 bytes use two overlapping word loads; the tail is one block that
+ * overlaps the previous one.
+ *
+ * Parameters:
+ * a - A pointer to the first memory area.
+ * b - A pointer to the second memory area.
+ * n - The number of bytes to compare.
+ *
+ * Returns:
+ * true if the areas are equal, false otherwise.
+ */
+
+LV_SSE2 bool	_lv_memeq_sse2(const void *a, const void *b, size_t n)
+{
+	const t_u8	*p;
+	const t_u8	*q;
+	__m128i		acc;
+
+	p = (const t_u8 *)a;
+	q = (const t_u8 *)b;
+	if (n < 16)
+	{
+		if (n >= 8)
+			return (!((*(const t_u64u *)p ^ *(const t_u64u *)q)
+				| (*(const t_u64u *)(p + n - 8)
+					^ *(const t_u64u *)(q + n - 8))));
+		if (n >= 4)
+			return (!((*(const t_u32u *)p ^ *(const t_u32u *)q)
+				| (*(const t_u32u *)(p + n - 4)
+					^ *(const t_u32u *)(q + n - 4))));
+		while (n--)
+			if (p[n] != q[n])
+				return (false);
+		return (true);
+	}
+	acc = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(p + n - 16)),
+			_mm_loadu_si128((const __m128i *)(q + n - 16)));
+	while (n >= 64)
+	{
+		acc = _mm_or_si128(acc, _mm_or_si128(
+					_mm_or_si128(
+						_mm_xor_si128(_mm_loadu_si128((const __m128i *)p),
+							_mm_loadu_si128((const __m128i *)q)),
+						_mm_xor_si128(_mm_loadu_si128((const __m128i *)(p + 16)),
+							_mm_loadu_si128((const __m128i *)(q + 16)))),
+					_mm_or_si128(
+						_mm_xor_si128(_mm_loadu_si128((const __m128i *)(p + 32)),
+							_mm_loadu_si128((const __m128i *)(q + 32))),
+						_mm_xor_si128(_mm_loadu_si128((const __m128i *)(p + 48)),
+							_mm_loadu_si128((const __m128i *)(q + 48))))));
+		if (_mm_movemask_epi8(_mm_cmpeq_epi8(acc, _mm_setzero_si128()))
+			!= 0xFFFF)
+			return (false);
+		p += 64;
+		q += 64;
+		n -= 64;
+	}
+	while (n >= 16)
+	{
+		acc = _mm_or_si128(acc, _mm_xor_si128(
+					_mm_loadu_si128((const __m128i *)p),
+					_mm_loadu_si128((const __m128i *)q)));
+		p += 16;
+		q += 16;
+		n -= 16;
+	}
+	return (_mm_movemask_epi8(_mm_cmpeq_epi8(acc, _mm_setzero_si128()))
+		== 0xFFFF);
+}
+
+/*
+ * Function: _lv_memeq_avx2
+ * ------------------------
+ * AVX2 variant of `lv_memeq`. Same structure as `_lv_memeq_sse2`, with
+ * 32-byte blocks tested with `vptest`.
+ */
+
+LV_AVX2 bool	_lv_memeq_avx2(const void *a, const void *b, size_t n)
+{
+	const t_u8	*p;
+	const t_u8	*q;
+	__m256i		acc;
+
+	p = (const t_u8 *)a;
+	q = (const t_u8 *)b;
+	if (n < 32)
+		return (_lv_memeq_sse2(a, b, n));
+	acc = _mm256_xor_si256(
+			_mm256_loadu_si256((const __m256i *)(p + n - 32)),
+			_mm256_loadu_si256((const __m256i *)(q + n - 32)));
+	while (n >= 128)
+	{
+		acc = _mm256_or_si256(acc, _mm256_or_si256(
+					_mm256_or_si256(
+						_mm256_xor_si256(
+							_mm256_loadu_si256((const __m256i *)p),
+							_mm256_loadu_si256((const __m256i *)q)),
+						_mm256_xor_si256(
+							_mm256_loadu_si256((const __m256i *)(p + 32)),
+							_mm256_loadu_si256((const __m256i *)(q + 32)))),
+					_mm256_or_si256(
+						_mm256_xor_si256(
+							_mm256_loadu_si256((const __m256i *)(p + 64)),
+							_mm256_loadu_si256((const __m256i *)(q + 64))),
+						_mm256_xor_si256(
+							_mm256_loadu_si256((const __m256i *)(p + 96)),
+							_mm256_loadu_si256((const __m256i *)(q + 96))))));
+		if (!_mm256_testz_si256(acc, acc))
+			return (false);
+		p += 128;
+		q += 128;
+		n -= 128;
+	}
+	while (n >= 32)
+	{
+		acc = _mm256_or_si256(acc, _mm256_xor_si256(
+					_mm256_loadu_si256((const __m256i *)p),
+					_mm256_loadu_si256((const __m256i *)q)));
+		p += 32;
+		q += 32;
+		n -= 32;
+	}
+	return (_mm256_testz_si256(acc, acc));
+}
+
+/*
+ * Function: _lv_memeq_avx512
+ * --------------------------
+ * AVX-512 variant of `lv_memeq`. Compares 64-byte blocks with
+ * `vpcmpneqb`; the tail is read with a byte-masked load.
+ */
+
+LV_AVX512 bool	_lv_memeq_avx512(const void *a, const void *b, size_t n)
+{
+	const t_u8	*p;
+	const t_u8	*q;
+	__mmask64	k;
+
+	p = (const t_u8 *)a;
+	q = (const t_u8 *)b;
+	while (n >= 256)
+	{
+		if (_mm512_cmpneq_epi8_mask(_mm512_loadu_si512(p),
+				_mm512_loadu_si512(q))
+			| _mm512_cmpneq_epi8_mask(_mm512_loadu_si512(p + 64),
+				_mm512_loadu_si512(q + 64))
+			| _mm512_cmpneq_epi8_mask(_mm512_loadu_si512(p + 128),
+				_mm512_loadu_si512(q + 128))
+			| _mm512_cmpneq_epi8_mask(_mm512_loadu_si512(p + 192),
+				_mm512_loadu_si512(q + 192)))
+			return (false);
+		p += 256;
+		q += 256;
+		n -= 256;
+	}
+	while (n)
+	{
+		k = (n < 64) ? (1ULL << n) - 1 : ~0ULL;
+		if (_mm512_cmpneq_epi8_mask(_mm512_maskz_loadu_epi8(k, p),
+				_mm512_maskz_loadu_epi8(k, q)))
+			return (false);
+		if (n <= 64)
+			break ;
+		p += 64;
+		q += 64;
+		n -= 64;
+	}
+	return (true);
+}
+
+/*
+ * Function: lv_memeq
+ * ------------------
+ * Tells whether the first `n` bytes of `a` and `b` are equal.
+ *
+ * Parameters:
+ * a - A pointer to the first memory area.
+ * b - A pointer to the second memory area.
+ * n - The number of bytes to compare.
+ *
+ * Returns:
+ * true if the areas are equal (or `n` is 0, or `a == b`), false
+ * otherwise or if exactly one of them is NULL.
+ *
+ * Notes:
+ * - Cheaper than `lv_memcmp` for equality checks (hash keys, dedup):
+ * it never has to locate the first difference, so it folds whole steps
+ * into one test.
+ * - The inputs may have any alignment.
+ */
+
+bool	lv_memeq(const void *__restrict__ a,
+	const void *__restrict__ b, size_t n)
+{
+	if (n == 0 || a == b)
+		return (true);
+	if (!a || !b)
+		return (false);
+	return (g_lv_mem.eq(a, b, n));
+}
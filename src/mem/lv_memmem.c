@@ -0,0 +1,227 @@
+/**
+ * lv_memmem.c
+ *
+ * Copyright (C) 2025 lvzrr <lvzrr@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General
+ * Public License along with this program. If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#include "mem.h"
+
+/*
+ * Function: _find_scalar
+ * ----------------------
+ * Checks the `count` candidate positions starting at `h` one by one,
+ * first and last byte first. Finishes the positions left over by the
+ * vector loops.
+ */
+
+LV_INLINE static inline void	*_find_scalar(const t_u8 *h, size_t count,
+	const t_u8 *nd, size_t len)
+{
+	size_t	j;
+
+	j = 0;
+	while (j < count)
+	{
+		if (h[j] == nd[0] && h[j + len - 1] == nd[len - 1]
+			&& _lv_memeq_sse2(h + j + 1, nd + 1, len - 2))
+			return ((void *)(h + j));
+		j++;
+	}
+	return (NULL);
+}
+
+/*
+ * Function: _lv_memmem_sse2
+ * -------------------------
+ * SSE2 variant of the short needle search. For 16 consecutive start
+ * positions at once, compares the haystack with the needle's first byte
+ * and, shifted by `len - 1`, with its last byte; only positions where
+ * both match are verified in full. Two bytes rule out almost every
+ * position of real text, so the verification rarely runs.
+ *
+ * Parameters:
+ * hay    - The memory area to be searched.
+ * n      - The number of bytes in `hay`.
+ * needle - The bytes to search for.
+ * len    - The length of `needle`, with `2 <= len <= n`.
+ *
+ * Returns:
+ * A pointer to the first occurrence of `needle` in `hay`, or NULL.
+ *
+ * Notes:
+ * - The cost of a verification grows with `len`, which is why longer
+ * needles are handed to Two-Way by the callers.
+ */
+
+LV_SSE2 void	*_lv_memmem_sse2(const void *hay, size_t n,
+	const void *needle, size_t len)
+{
+	const t_u8	*h;
+	const t_u8	*nd;
+	__m128i		f;
+	__m128i		l;
+	size_t		i;
+	t_u32		m;
+
+	h = (const t_u8 *)hay;
+	nd = (const t_u8 *)needle;
+	f = _mm_set1_epi8((char)nd[0]);
+	l = _mm_set1_epi8((char)nd[len - 1]);
+	n -= len - 1;
+	i = 0;
+	while (n - i >= 16)
+	{
+		m = (t_u32)_mm_movemask_epi8(_mm_and_si128(
+					_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(h + i)), f),
+					_mm_cmpeq_epi8(_mm_loadu_si128(
+							(const __m128i *)(h + i + len - 1)), l)));
+		while (m)
+		{
+			if (_lv_memeq_sse2(h + i + __builtin_ctz(m) + 1, nd + 1, len - 2))
+				return ((void *)(h + i + __builtin_ctz(m)));
+			m &= m - 1;
+		}
+		i += 16;
+	}
+	return (_find_scalar(h + i, n - i, nd, len));
+}
+
+/*
+ * Function: _lv_memmem_avx2
+ * -------------------------
+ * AVX2 variant of the short needle search. Same filter as
+ * `_lv_memmem_sse2`, 32 start positions per step.
+ */
+
+LV_AVX2 void	*_lv_memmem_avx2(const void *hay, size_t n,
+	const void *needle, size_t len)
+{
+	const t_u8	*h;
+	const t_u8	*nd;
+	__m256i		f;
+	__m256i		l;
+	size_t		i;
+	t_u32		m;
+
+	h = (const t_u8 *)hay;
+	nd = (const t_u8 *)needle;
+	f = _mm256_set1_epi8((char)nd[0]);
+	l = _mm256_set1_epi8((char)nd[len - 1]);
+	n -= len - 1;
+	i = 0;
+	while (n - i >= 32)
+	{
+		m = (t_u32)_mm256_movemask_epi8(_mm256_and_si256(
+					_mm256_cmpeq_epi8(_mm256_loadu_si256(
+							(const __m256i *)(h + i)), f),
+					_mm256_cmpeq_epi8(_mm256_loadu_si256(
+							(const __m256i *)(h + i + len - 1)), l)));
+		while (m)
+		{
+			if (_lv_memeq_avx2(h + i + __builtin_ctz(m) + 1, nd + 1, len - 2))
+				return ((void *)(h + i + __builtin_ctz(m)));
+			m &= m - 1;
+		}
+		i += 32;
+	}
+	return (_find_scalar(h + i, n - i, nd, len));
+}
+
+/*
+ * Function: _lv_memmem_avx512
+ * ---------------------------
+ * AVX-512 variant of the short needle search. Same filter with 64 start
+ * positions per step; the last partial step uses byte-masked loads, so
+ * there is no scalar tail.
+ */
+
+LV_AVX512 void	*_lv_memmem_avx512(const void *hay, size_t n,
+	const void *needle, size_t len)
+{
+	const t_u8	*h;
+	const t_u8	*nd;
+	__m512i		f;
+	__m512i		l;
+	__mmask64	k;
+	t_u64		m;
+	size_t		i;
+
+	h = (const t_u8 *)hay;
+	nd = (const t_u8 *)needle;
+	f = _mm512_set1_epi8((char)nd[0]);
+	l = _mm512_set1_epi8((char)nd[len - 1]);
+	n -= len - 1;
+	i = 0;
+	while (i < n)
+	{
+		k = (n - i < 64) ? (1ULL << (n - i)) - 1 : ~0ULL;
+		m = _mm512_mask_cmpeq_epi8_mask(
+				_mm512_mask_cmpeq_epi8_mask(k,
+					_mm512_maskz_loadu_epi8(k, h + i), f),
+				_mm512_maskz_loadu_epi8(k, h + i + len - 1), l);
+		while (m)
+		{
+			if (_lv_memeq_avx512(h + i + __builtin_ctzll(m) + 1, nd + 1,
+					len - 2))
+				return ((void *)(h + i + __builtin_ctzll(m)));
+			m &= m - 1;
+		}
+		i += 64;
+	}
+	return (NULL);
+}
+
+/*
+ * Function: lv_memmem
+ * -------------------
+ * Finds the first occurrence of the `len` bytes of `needle` in the `n`
+ * bytes of `hay`.
+ *
+ * Parameters:
+ * hay    - The memory area to be searched.
+ * n      - The number of bytes in `hay`.
+ * needle - The bytes to search for.
+ * len    - The length of `needle`.
+ *
+ * Returns:
+ * A pointer to the first occurrence, `hay` if `len` is 0, or NULL if
+ * there is none (or if `hay` or `needle` is NULL).
+ *
+ * Notes:
+ * - One byte needles go to `lv_memchr`, needles up to `LV_SEARCH_SHORT`
+ * bytes to the SIMD first/last byte filter picked by `lv_cpu_dispatch`,
+ * and longer ones to Two-Way, which is linear in `n` whatever the input.
+ * - The long needle path builds a `t_searcher` on every call. To search
+ * many haystacks for the same needle, build it once with
+ * `lv_searcher_init` and call `lv_searcher_find` instead.
+ */
+
+void	*lv_memmem(const void *hay, size_t n, const void *needle, size_t len)
+{
+	t_searcher	s;
+
+	if (!len)
+		return ((void *)hay);
+	if (!hay || !needle || len > n)
+		return (NULL);
+	if (len == 1)
+		return (lv_memchr(hay, *(const t_u8 *)needle, n));
+	if (len <= LV_SEARCH_SHORT)
+		return (g_lv_mem.find(hay, n, needle, len));
+	lv_searcher_init(&s, needle, len);
+	return (lv_searcher_find(&s, hay, n));
+}
@@ -21,55 +21,287 @@
 #include "mem.h"
 
 /*
- * Function: b
- * -----------
- * Helper function for `lv_memmove` specifically for backward copying.
- * This is invoked when the source and destination memory regions overlap
- * and the destination starts before the source, requiring a copy from
- * the end of the region backward to prevent overwriting uncopied data.
+ * Function: _lv_memmove_sse2
+ * --------------------------
+ * SSE2 variant of `lv_memmove`. Regions that do not overlap are handed
+ * to `_lv_memcpy_sse2`. Overlapping regions are copied forwards when
+ * `dest` is below `src` and backwards otherwise, so every block is loaded
+ * before any store can reach it. The bulk is moved with unaligned 128-bit
+ * loads and stores aligned on `dest`, whatever the alignment of `src`;
+ * the ends are moved byte by byte.
  *
  * Parameters:
- * dest - A pointer to the destination memory region (adjusted for backward copy).
- * src  - A pointer to the source memory region (adjusted for backward copy).
+ * dest - A pointer to the destination memory area.
+ * src  - A pointer to the source memory area.
  * n    - The number of bytes to copy.
  *
  * Returns:
- * None.
+ * A pointer to the destination memory area `dest`.
  *
  * Notes:
- * - This function is `always_inline` for performance critical paths.
- * - It handles initial unaligned bytes, then performs backward word-sized
- * copies (128-bit, 64-bit, 32-bit), and finally falls back to byte-wise
- * backward copy for remaining bytes.
- * - The pointers `dest` and `src` are expected to be incremented by `n`
- * by the caller before calling this function, effectively pointing to
- * the end of the respective regions for backward iteration.
+ * - Within each unrolled step all loads are issued before the stores.
+ * In the forward case `dest < src`, in the backward case `dest > src`,
+ * so a store never lands on bytes that a later step still has to read.
  */
 
-LV_INLINE inline void	b(void *__restrict__ dest,
-	const void *__restrict__ src, size_t n)
+LV_SSE2 void	*_lv_memmove_sse2(void *dest, const void *src, size_t n)
+{
+	t_u8		*d;
+	const t_u8	*s;
+	__m128i		v[4];
+
+	if ((t_uptr)dest - (t_uptr)src >= n && (t_uptr)src - (t_uptr)dest >= n)
+		return (_lv_memcpy_sse2(dest, src, n));
+	d = (t_u8 *)dest;
+	s = (const t_u8 *)src;
+	if (d < s)
+	{
+		while (n && ((t_uptr)d & 15))
+		{
+			*d++ = *s++;
+			--n;
+		}
+		while (n >= 64)
+		{
+			v[0] = _mm_loadu_si128((const __m128i *)s);
+			v[1] = _mm_loadu_si128((const __m128i *)(s + 16));
+			v[2] = _mm_loadu_si128((const __m128i *)(s + 32));
+			v[3] = _mm_loadu_si128((const __m128i *)(s + 48));
+			_mm_store_si128((__m128i *)d, v[0]);
+			_mm_store_si128((__m128i *)(d + 16), v[1]);
+			_mm_store_si128((__m128i *)(d + 32), v[2]);
+			_mm_store_si128((__m128i *)(d + 48), v[3]);
+			d += 64;
+			s += 64;
+			n -= 64;
+		}
+		while (n >= 16)
+		{
+			_mm_store_si128((__m128i *)d,
+				_mm_loadu_si128((const __m128i *)s));
+			d += 16;
+			s += 16;
+			n -= 16;
+		}
+		while (n)
+		{
+			*d++ = *s++;
+			--n;
+		}
+		return (dest);
+	}
+	d += n;
+	s += n;
+	while (n && ((t_uptr)d & 15))
+	{
+		*--d = *--s;
+		--n;
+	}
+	while (n >= 64)
+	{
+		v[0] = _mm_loadu_si128((const __m128i *)(s - 16));
+		v[1] = _mm_loadu_si128((const __m128i *)(s - 32));
+		v[2] = _mm_loadu_si128((const __m128i *)(s - 48));
+		v[3] = _mm_loadu_si128((const __m128i *)(s - 64));
+		_mm_store_si128((__m128i *)(d - 16), v[0]);
+		_mm_store_si128((__m128i *)(d - 32), v[1]);
+		_mm_store_si128((__m128i *)(d - 48), v[2]);
+		_mm_store_si128((__m128i *)(d - 64), v[3]);
+		d -= 64;
+		s -= 64;
+		n -= 64;
+	}
+	while (n >= 16)
+	{
+		d -= 16;
+		s -= 16;
+		_mm_store_si128((__m128i *)d, _mm_loadu_si128((const __m128i *)s));
+		n -= 16;
+	}
+	while (n)
+	{
+		*--d = *--s;
+		--n;
+	}
+	return (dest);
+}
+
+/*
+ * Function: _lv_memmove_avx2
+ * --------------------------
+ * AVX2 variant of `lv_memmove`. Same structure as `_lv_memmove_sse2`,
+ * with 32-byte alignment and 256-bit registers.
+ */
+
+LV_AVX2 void	*_lv_memmove_avx2(void *dest, const void *src, size_t n)
+{
+	t_u8		*d;
+	const t_u8	*s;
+	__m256i		v[4];
+
+	if ((t_uptr)dest - (t_uptr)src >= n && (t_uptr)src - (t_uptr)dest >= n)
+		return (_lv_memcpy_avx2(dest, src, n));
+	d = (t_u8 *)dest;
+	s = (const t_u8 *)src;
+	if (d < s)
+	{
+		while (n && ((t_uptr)d & 31))
+		{
+			*d++ = *s++;
+			--n;
+		}
+		while (n >= 128)
+		{
+			v[0] = _mm256_loadu_si256((const __m256i *)s);
+			v[1] = _mm256_loadu_si256((const __m256i *)(s + 32));
+			v[2] = _mm256_loadu_si256((const __m256i *)(s + 64));
+			v[3] = _mm256_loadu_si256((const __m256i *)(s + 96));
+			_mm256_store_si256((__m256i *)d, v[0]);
+			_mm256_store_si256((__m256i *)(d + 32), v[1]);
+			_mm256_store_si256((__m256i *)(d + 64), v[2]);
+			_mm256_store_si256((__m256i *)(d + 96), v[3]);
+			d += 128;
+			s += 128;
+			n -= 128;
+		}
+		while (n >= 32)
+		{
+			_mm256_store_si256((__m256i *)d,
+				_mm256_loadu_si256((const __m256i *)s));
+			d += 32;
+			s += 32;
+			n -= 32;
+		}
+		while (n)
+		{
+			*d++ = *s++;
+			--n;
+		}
+		return (dest);
+	}
+	d += n;
+	s += n;
+	while (n && ((t_uptr)d & 31))
+	{
+		*--d = *--s;
+		--n;
+	}
+	while (n >= 128)
+	{
+		v[0] = _mm256_loadu_si256((const __m256i *)(s - 32));
+		v[1] = _mm256_loadu_si256((const __m256i *)(s - 64));
+		v[2] = _mm256_loadu_si256((const __m256i *)(s - 96));
+		v[3] = _mm256_loadu_si256((const __m256i *)(s - 128));
+		_mm256_store_si256((__m256i *)(d - 32), v[0]);
+		_mm256_store_si256((__m256i *)(d - 64), v[1]);
+		_mm256_store_si256((__m256i *)(d - 96), v[2]);
+		_mm256_store_si256((__m256i *)(d - 128), v[3]);
+		d -= 128;
+		s -= 128;
+		n -= 128;
+	}
+	while (n >= 32)
+	{
+		d -= 32;
+		s -= 32;
+		_mm256_store_si256((__m256i *)d,
+			_mm256_loadu_si256((const __m256i *)s));
+		n -= 32;
+	}
+	while (n)
+	{
+		*--d = *--s;
+		--n;
+	}
+	return (dest);
+}
+
+/*
+ * Function: _lv_memmove_avx512
+ * ----------------------------
+ * AVX-512 variant of `lv_memmove`. Same structure as `_lv_memmove_sse2`,
+ * with 64-byte alignment and 512-bit registers.
+ */
+
+LV_AVX512 void	*_lv_memmove_avx512(void *dest, const void *src, size_t n)
 {
-	size_t	i;
-	t_u8	r;
+	t_u8		*d;
+	const t_u8	*s;
+	__m512i		v[4];
 
-	i = 0;
-	r = _aligned((t_u8 *)dest, (t_u8 *)src, &i);
-	while (n >= 2 && !r)
+	if ((t_uptr)dest - (t_uptr)src >= n && (t_uptr)src - (t_uptr)dest >= n)
+		return (_lv_memcpy_avx512(dest, src, n));
+	d = (t_u8 *)dest;
+	s = (const t_u8 *)src;
+	if (d < s)
+	{
+		while (n && ((t_uptr)d & 63))
+		{
+			*d++ = *s++;
+			--n;
+		}
+		while (n >= 256)
+		{
+			v[0] = _mm512_loadu_si512(s);
+			v[1] = _mm512_loadu_si512(s + 64);
+			v[2] = _mm512_loadu_si512(s + 128);
+			v[3] = _mm512_loadu_si512(s + 192);
+			_mm512_store_si512(d, v[0]);
+			_mm512_store_si512(d + 64, v[1]);
+			_mm512_store_si512(d + 128, v[2]);
+			_mm512_store_si512(d + 192, v[3]);
+			d += 256;
+			s += 256;
+			n -= 256;
+		}
+		while (n >= 64)
+		{
+			_mm512_store_si512(d, _mm512_loadu_si512(s));
+			d += 64;
+			s += 64;
+			n -= 64;
+		}
+		while (n)
+		{
+			*d++ = *s++;
+			--n;
+		}
+		return (dest);
+	}
+	d += n;
+	s += n;
+	while (n && ((t_uptr)d & 63))
+	{
+		*--d = *--s;
+		--n;
+	}
+	while (n >= 256)
 	{
-		((t_u8 *)dest)[i] = ((t_u8 *)src)[i];
-		((t_u8 *)dest)[i + 1] = ((t_u8 *)src)[i + 1];
-		i += sizeof(t_u8) * 2;
-		n -= sizeof(t_u8) * 2;
-		r = _aligned((t_u8 *)dest, (t_u8 *)src, &i);
+		v[0] = _mm512_loadu_si512(s - 64);
+		v[1] = _mm512_loadu_si512(s - 128);
+		v[2] = _mm512_loadu_si512(s - 192);
+		v[3] = _mm512_loadu_si512(s - 256);
+		_mm512_store_si512(d - 64, v[0]);
+		_mm512_store_si512(d - 128, v[1]);
+		_mm512_store_si512(d - 192, v[2]);
+		_mm512_store_si512(d - 256, v[3]);
+		d -= 256;
+		s -= 256;
+		n -= 256;
 	}
-	if (n > sizeof(t_u128) * 2 && r == 128)
-		_copy_u128_bw((t_u8 *)dest + n, (t_u8 *)src + n, &n, &i);
-	else if (n > sizeof(t_u64) * 2 && r >=  64)
-		_copy_u64_bw((t_u8 *)dest + n, (t_u8 *)src + n, &n, &i);
-	else if (n > sizeof(t_u32) * 32 && r >= 32)
-		_copy_u32_bw((t_u8 *)dest + n, (t_u8 *)src + n, &n, &i);
-	if (n > 0)
-		_copy_u8_bw((t_u8 *)dest + n, (t_u8 *)src + n, &n, &i);
+	while (n >= 64)
+	{
+		d -= 64;
+		s -= 64;
+		_mm512_store_si512(d, _mm512_loadu_si512(s));
+		n -= 64;
+	}
+	while (n)
+	{
+		*--d = *--s;
+		--n;
+	}
+	return (dest);
 }
 
 /*
@@ -88,22 +320,21 @@ LV_INLINE inline void	b(void *__restrict__ dest,
  *
  * Notes:
  * - This function is marked `hot` indicating it's expected to be called frequently.
- * - It handles overlapping memory regions by determining if a forward copy
- * (using `lv_memcpy`) or a backward copy (using the internal `b` helper)
- * is necessary.
- * - If `dest` and `src` are the same, or `n` is 0 and `dest` or `src` is NULL,
- * it immediately returns `dest`.
+ * - The move is done by the SSE2, AVX2 or AVX-512 variant picked at
+ * load time by `lv_cpu_dispatch`; each variant chooses between a forward
+ * and a backward copy depending on how the regions overlap.
+ * - Moves of up to `LV_SMALL_COPY` bytes use `_lv_memcpy_small`, which
+ * loads everything before storing and so handles any overlap.
+ * - If `dest` or `src` is NULL, or `dest == src`, and `n` is not 0,
+ * it returns NULL.
  */
 
-LV_SIMD LV_INLINE_HOT inline void	*lv_memmove(void *__restrict__ dest,
+LV_HOT void	*lv_memmove(void *__restrict__ dest,
 	const void *__restrict__ src, size_t n)
 {
 	if ((!dest || !src || dest == src) && n != 0)
 		return (NULL);
-	if ((t_uptr)src < (t_uptr)dest
-		&& (t_uptr)src + n >= (t_uptr)dest)
-		b(dest, src, n);
-	else
-		lv_memcpy(dest, src, n);
-	return (dest);
+	if (n <= LV_SMALL_COPY)
+		return (_lv_memcpy_small(dest, src, n));
+	return (g_lv_mem.move(dest, src, n));
 }
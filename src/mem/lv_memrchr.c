@@ -0,0 +1,201 @@
+/**
+ * lv_memrchr.c
+ *
+ * Copyright (C) 2025 lvzrr <lvzrr@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General
+ * Public License along with this program. If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#include "mem.h"
+
+/*
+ * Function: _lv_memrchr_sse2
+ * --------------------------
+ * SSE2 variant of `lv_memrchr`. Walks aligned 16-byte blocks from the one
+ * holding `ptr + n - 1` down to the one holding `ptr`, masking the bytes
+ * past the end in the first block and the bytes before `ptr` in the last
+ * one, and takes the highest set bit of the `pmovmskb` mask on a hit.
+ * Aligned blocks never cross a page boundary.
+ *
+ * Parameters:
+ * ptr - A pointer to the memory area to be searched.
+ * c   - The character to search for (treated as an unsigned char).
+ * n   - The number of bytes to search, at least 1.
+ *
+ * Returns:
+ * A pointer to the last matching byte, or NULL if it is not found.
+ */
+
+LV_SSE2 void	*_lv_memrchr_sse2(const void *ptr, int c, size_t n)
+{
+	const t_u8	*p;
+	__m128i		v;
+	t_u64		m;
+	size_t		r;
+
+	v = _mm_set1_epi8((char)c);
+	p = (const t_u8 *)(((t_uptr)ptr + n - 1) & ~(t_uptr)15);
+	m = (t_u32)_mm_movemask_epi8(_mm_cmpeq_epi8(
+				_mm_load_si128((const __m128i *)p), v));
+	m &= (1ULL << ((t_uptr)ptr + n - (t_uptr)p)) - 1;
+	if ((t_uptr)p <= (t_uptr)ptr)
+		m &= ~0ULL << ((t_uptr)ptr - (t_uptr)p);
+	if (m || (t_uptr)p <= (t_uptr)ptr)
+		return (m ? (void *)(p + 63 - __builtin_clzll(m)) : NULL);
+	r = (t_uptr)p - (t_uptr)ptr;
+	while (r >= 64)
+	{
+		p -= 64;
+		r -= 64;
+		m = (t_u64)(t_u32)_mm_movemask_epi8(_mm_cmpeq_epi8(
+					_mm_load_si128((const __m128i *)p), v))
+			| (t_u64)(t_u32)_mm_movemask_epi8(_mm_cmpeq_epi8(
+					_mm_load_si128((const __m128i *)(p + 16)), v)) << 16
+			| (t_u64)(t_u32)_mm_movemask_epi8(_mm_cmpeq_epi8(
+					_mm_load_si128((const __m128i *)(p + 32)), v)) << 32
+			| (t_u64)(t_u32)_mm_movemask_epi8(_mm_cmpeq_epi8(
+					_mm_load_si128((const __m128i *)(p + 48)), v)) << 48;
+		if (m)
+			return ((void *)(p + 63 - __builtin_clzll(m)));
+	}
+	while (r)
+	{
+		p -= 16;
+		m = (t_u32)_mm_movemask_epi8(_mm_cmpeq_epi8(
+					_mm_load_si128((const __m128i *)p), v));
+		if (r < 16)
+			m &= ~0ULL << (16 - r);
+		if (m)
+			return ((void *)(p + 63 - __builtin_clzll(m)));
+		r -= (r < 16) ? r : 16;
+	}
+	return (NULL);
+}
+
+/*
+ * Function: _lv_memrchr_avx2
+ * --------------------------
+ * AVX2 variant of `lv_memrchr`. Same structure as `_lv_memrchr_sse2`,
+ * with 32-byte blocks.
+ */
+
+LV_AVX2 void	*_lv_memrchr_avx2(const void *ptr, int c, size_t n)
+{
+	const t_u8	*p;
+	__m256i		v;
+	t_u64		m;
+	size_t		r;
+
+	v = _mm256_set1_epi8((char)c);
+	p = (const t_u8 *)(((t_uptr)ptr + n - 1) & ~(t_uptr)31);
+	m = (t_u32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(
+				_mm256_load_si256((const __m256i *)p), v));
+	m &= (1ULL << ((t_uptr)ptr + n - (t_uptr)p)) - 1;
+	if ((t_uptr)p <= (t_uptr)ptr)
+		m &= ~0ULL << ((t_uptr)ptr - (t_uptr)p);
+	if (m || (t_uptr)p <= (t_uptr)ptr)
+		return (m ? (void *)(p + 63 - __builtin_clzll(m)) : NULL);
+	r = (t_uptr)p - (t_uptr)ptr;
+	while (r >= 64)
+	{
+		p -= 64;
+		r -= 64;
+		m = (t_u32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(
+					_mm256_load_si256((const __m256i *)p), v))
+			| (t_u64)(t_u32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(
+					_mm256_load_si256((const __m256i *)(p + 32)), v)) << 32;
+		if (m)
+			return ((void *)(p + 63 - __builtin_clzll(m)));
+	}
+	while (r)
+	{
+		p -= 32;
+		m = (t_u32)_mm256_movemask_epi8(_mm256_cmpeq_epi8(
+					_mm256_load_si256((const __m256i *)p), v));
+		if (r < 32)
+			m &= ~0ULL << (32 - r);
+		if (m)
+			return ((void *)(p + 63 - __builtin_clzll(m)));
+		r -= (r < 32) ? r : 32;
+	}
+	return (NULL);
+}
+
+/*
+ * Function: _lv_memrchr_avx512
+ * ----------------------------
+ * AVX-512 variant of `lv_memrchr`. Same structure as `_lv_memrchr_sse2`,
+ * with 64-byte blocks and `vpcmpeqb` mask registers.
+ */
+
+LV_AVX512 void	*_lv_memrchr_avx512(const void *ptr, int c, size_t n)
+{
+	const t_u8	*p;
+	__m512i		v;
+	t_u64		m;
+	size_t		r;
+
+	v = _mm512_set1_epi8((char)c);
+	p = (const t_u8 *)(((t_uptr)ptr + n - 1) & ~(t_uptr)63);
+	m = _mm512_cmpeq_epi8_mask(_mm512_load_si512(p), v);
+	r = (t_uptr)ptr + n - (t_uptr)p;
+	if (r < 64)
+		m &= (1ULL << r) - 1;
+	if ((t_uptr)p <= (t_uptr)ptr)
+		m &= ~0ULL << ((t_uptr)ptr - (t_uptr)p);
+	if (m || (t_uptr)p <= (t_uptr)ptr)
+		return (m ? (void *)(p + 63 - __builtin_clzll(m)) : NULL);
+	r = (t_uptr)p - (t_uptr)ptr;
+	while (r)
+	{
+		p -= 64;
+		m = _mm512_cmpeq_epi8_mask(_mm512_load_si512(p), v);
+		if (r < 64)
+			m &= ~0ULL << (64 - r);
+		if (m)
+			return ((void *)(p + 63 - __builtin_clzll(m)));
+		r -= (r < 64) ? r : 64;
+	}
+	return (NULL);
+}
+
+/*
+ * Function: lv_memrchr
+ * --------------------
+ * Scans the initial `n` bytes of the memory area pointed to by `ptr`
+ * backwards for the last occurrence of the character `c`.
+ *
+ * Parameters:
+ * ptr - A pointer to the memory area to be searched.
+ * c   - The character to search for (treated as an unsigned char).
+ * n   - The number of bytes to search.
+ *
+ * Returns:
+ * A pointer to the last matching byte, or NULL if the character `c`
+ * does not occur in the first `n` bytes of the memory area.
+ *
+ * Notes:
+ * - The scan is done by the SSE2, AVX2 or AVX-512 variant picked at
+ * load time by `lv_cpu_dispatch`.
+ * - Like `lv_memchr`, it only loads aligned blocks, so it never reads
+ * from a page outside the range.
+ */
+
+void	*lv_memrchr(const void *__restrict__ ptr, int c, size_t n)
+{
+	if (!ptr || !n)
+		return (NULL);
+	return (g_lv_mem.rchr(ptr, c, n));
+}
@@ -0,0 +1,305 @@
+/**
+ * lv_memrev.c
+ *
+ * Copyright (C) 2025 lvzrr <lvzrr@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General
+ * Public License along with this program. If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#include "mem.h"
+
+/*
+ * In-lane element reversal masks for `pshufb`, one per element size
+ * (1, 2, 4 and 8 bytes): byte j of a 16-byte lane takes byte
+ * mask[j] of the source lane.
+ */
+
+static const t_u8	g_rev_mask[4][16] LV_ALIGN(16) = {
+{15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0},
+{14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1},
+{12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3},
+{8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7},
+};
+
+/*
+ * Function: _swap_block
+ * ---------------------
+ * Swaps two non-overlapping `w` byte elements, 16 bytes at a time.
+ */
+
+LV_SSE2 LV_INLINE static inline void	_swap_block(t_u8 *a, t_u8 *b, size_t w)
+{
+	__m128i	x;
+	__m128i	y;
+	t_u8	t;
+
+	while (w >= 16)
+	{
+		x = _mm_loadu_si128((const __m128i *)a);
+		y = _mm_loadu_si128((const __m128i *)b);
+		_mm_storeu_si128((__m128i *)a, y);
+		_mm_storeu_si128((__m128i *)b, x);
+		a += 16;
+		b += 16;
+		w -= 16;
+	}
+	if (w >= 8)
+	{
+		x = _mm_loadl_epi64((const __m128i *)a);
+		y = _mm_loadl_epi64((const __m128i *)b);
+		_mm_storel_epi64((__m128i *)a, y);
+		_mm_storel_epi64((__m128i *)b, x);
+		a += 8;
+		b += 8;
+		w -= 8;
+	}
+	while (w--)
+	{
+		t = *a;
+		*a++ = *b;
+		*b++ = t;
+	}
+}
+
+/*
+ * Function: _rev_elems
+ * --------------------
+ * Reverses the `w` byte elements of [lo, hi) one pair at a time. Generic
+ * path for element sizes without a lane kernel, and tail of the others.
+ */
+
+LV_SSE2 LV_INLINE static inline void	_rev_elems(t_u8 *lo, t_u8 *hi,
+	size_t w)
+{
+	while ((size_t)(hi - lo) >= 2 * w)
+	{
+		hi -= w;
+		_swap_block(lo, hi, w);
+		lo += w;
+	}
+}
+
+/*
+ * Function: _rev128_sse2
+ * ----------------------
+ * Reverses the order of the `w` byte elements of a 16-byte vector with
+ * SSE2 shuffles only: dwords with `pshufd`, words with `pshuflw` and
+ * `pshufhw` on top, bytes by also swapping the halves of every word.
+ */
+
+LV_SSE2 LV_INLINE static inline __m128i	_rev128_sse2(__m128i x, size_t w)
+{
+	if (w == 8)
+		return (_mm_shuffle_epi32(x, 0x4E));
+	if (w == 4)
+		return (_mm_shuffle_epi32(x, 0x1B));
+	x = _mm_shuffle_epi32(x, 0x4E);
+	x = _mm_shufflehi_epi16(_mm_shufflelo_epi16(x, 0x1B), 0x1B);
+	if (w == 2)
+		return (x);
+	return (_mm_or_si128(_mm_slli_epi16(x, 8), _mm_srli_epi16(x, 8)));
+}
+
+/*
+ * Function: _rev_lanes_sse2
+ * -------------------------
+ * Main loop of the SSE2 variant for one element size: swaps 16 bytes
+ * from each end per step, reversing both. Returns the unreversed middle
+ * through `lo` and `hi`.
+ */
+
+LV_SSE2 LV_INLINE static inline void	_rev_lanes_sse2(t_u8 **lo, t_u8 **hi,
+	size_t w)
+{
+	__m128i	a;
+	__m128i	b;
+
+	while (*hi - *lo >= 32)
+	{
+		*hi -= 16;
+		a = _mm_loadu_si128((const __m128i *)*lo);
+		b = _mm_loadu_si128((const __m128i *)*hi);
+		_mm_storeu_si128((__m128i *)*lo, _rev128_sse2(b, w));
+		_mm_storeu_si128((__m128i *)*hi, _rev128_sse2(a, w));
+		*lo += 16;
+	}
+}
+
+/*
+ * Function: _lv_memrev_sse2
+ * -------------------------
+ * SSE2 variant of `lv_memrev`. Elements of 1, 2, 4 or 8 bytes are
+ * reversed a vector at a time from both ends, the middle (less than
+ * 32 bytes) and other element sizes element by element.
+ *
+ * Parameters:
+ * ptr - The array to reverse.
+ * n   - The number of elements, at least 2.
+ * w   - The size of an element in bytes, at least 1.
+ *
+ * Returns:
+ * None.
+ */
+
+LV_SSE2 void	_lv_memrev_sse2(void *ptr, size_t n, size_t w)
+{
+	t_u8	*lo;
+	t_u8	*hi;
+
+	lo = ptr;
+	hi = lo + n * w;
+	if (w == 1)
+		_rev_lanes_sse2(&lo, &hi, 1);
+	else if (w == 2)
+		_rev_lanes_sse2(&lo, &hi, 2);
+	else if (w == 4)
+		_rev_lanes_sse2(&lo, &hi, 4);
+	else if (w == 8)
+		_rev_lanes_sse2(&lo, &hi, 8);
+	_rev_elems(lo, hi, w);
+}
+
+/*
+ * Function: _rev_mid
+ * ------------------
+ * Middle of the AVX2 and AVX-512 variants: one `pshufb` reversal of 16
+ * bytes from each end per step, while at least 32 bytes remain.
+ */
+
+LV_AVX2 LV_INLINE static inline void	_rev_mid(t_u8 **lo, t_u8 **hi,
+	__m128i m)
+{
+	__m128i	a;
+	__m128i	b;
+
+	while (*hi - *lo >= 32)
+	{
+		*hi -= 16;
+		a = _mm_loadu_si128((const __m128i *)*lo);
+		b = _mm_loadu_si128((const __m128i *)*hi);
+		_mm_storeu_si128((__m128i *)*lo, _mm_shuffle_epi8(b, m));
+		_mm_storeu_si128((__m128i *)*hi, _mm_shuffle_epi8(a, m));
+		*lo += 16;
+	}
+}
+
+/*
+ * Function: _lv_memrev_avx2
+ * -------------------------
+ * AVX2 variant of `lv_memrev`: for 1, 2, 4 and 8 byte elements, 32
+ * bytes from each end per step, reversed with an in-lane `vpshufb`
+ * and a `vpermq` swapping the two lanes.
+ */
+
+LV_AVX2 void	_lv_memrev_avx2(void *ptr, size_t n, size_t w)
+{
+	t_u8	*lo;
+	t_u8	*hi;
+	__m256i	m;
+	__m256i	a;
+	__m256i	b;
+
+	lo = ptr;
+	hi = lo + n * w;
+	if (w > 8 || (w & (w - 1)))
+	{
+		_rev_elems(lo, hi, w);
+		return ;
+	}
+	m = _mm256_broadcastsi128_si256(
+			_mm_load_si128((const __m128i *)g_rev_mask[__builtin_ctzll(w)]));
+	while (hi - lo >= 64)
+	{
+		hi -= 32;
+		a = _mm256_loadu_si256((const __m256i *)lo);
+		b = _mm256_loadu_si256((const __m256i *)hi);
+		_mm256_storeu_si256((__m256i *)lo,
+			_mm256_permute4x64_epi64(_mm256_shuffle_epi8(b, m), 0x4E));
+		_mm256_storeu_si256((__m256i *)hi,
+			_mm256_permute4x64_epi64(_mm256_shuffle_epi8(a, m), 0x4E));
+		lo += 32;
+	}
+	_rev_mid(&lo, &hi, _mm256_castsi256_si128(m));
+	_rev_elems(lo, hi, w);
+}
+
+/*
+ * Function: _lv_memrev_avx512
+ * ---------------------------
+ * AVX-512 variant of `lv_memrev`: 64 bytes from each end per step, an
+ * in-lane `vpshufb` followed by a `vshufi64x2` reversing the four lanes.
+ */
+
+LV_AVX512 void	_lv_memrev_avx512(void *ptr, size_t n, size_t w)
+{
+	t_u8	*lo;
+	t_u8	*hi;
+	__m512i	m;
+	__m512i	a;
+	__m512i	b;
+
+	lo = ptr;
+	hi = lo + n * w;
+	if (w > 8 || (w & (w - 1)))
+	{
+		_rev_elems(lo, hi, w);
+		return ;
+	}
+	m = _mm512_broadcast_i32x4(
+			_mm_load_si128((const __m128i *)g_rev_mask[__builtin_ctzll(w)]));
+	while (hi - lo >= 128)
+	{
+		hi -= 64;
+		a = _mm512_loadu_si512(lo);
+		b = _mm512_loadu_si512(hi);
+		b = _mm512_shuffle_epi8(b, m);
+		a = _mm512_shuffle_epi8(a, m);
+		_mm512_storeu_si512(lo, _mm512_shuffle_i64x2(b, b, 0x1B));
+		_mm512_storeu_si512(hi, _mm512_shuffle_i64x2(a, a, 0x1B));
+		lo += 64;
+	}
+	_rev_mid(&lo, &hi, _mm512_castsi512_si128(m));
+	_rev_elems(lo, hi, w);
+}
+
+/*
+ * Function: lv_memrev
+ * -------------------
+ * Reverses, in place, the order of the `n` elements of `width` bytes
+ * starting at `ptr`.
+ *
+ * Parameters:
+ * ptr   - The array to reverse.
+ * n     - The number of elements.
+ * width - The size of one element in bytes.
+ *
+ * Returns:
+ * None.
+ *
+ * Notes:
+ * - Does nothing if `ptr` is NULL, `n` is below 2 or `width` is 0.
+ * - Elements of 1, 2, 4 and 8 bytes are reversed whole vectors at a
+ * time from both ends (SSE2, AVX2 or AVX-512, picked at load time by
+ * `lv_cpu_dispatch`); other sizes are swapped pairwise in 16-byte
+ * blocks, with no temporary buffer.
+ * - `n * width` must not overflow.
+ */
+
+void	lv_memrev(void *ptr, size_t n, size_t width)
+{
+	if (!ptr || n < 2 || !width)
+		return ;
+	g_lv_mem.rev(ptr, n, width);
+}
@@ -20,43 +20,180 @@
 
 #include "mem.h"
 
-
 /*
- * Function: _alinger
- * ------------------
- * Helper function for `lv_memset` to handle initial unaligned bytes
- * and attempt to align the destination pointer for more efficient word-sized writes.
- * It writes the specified byte `o` two at a time until alignment is achieved.
+ * Function: _lv_memset_sse2
+ * -------------------------
+ * SSE2 variant of `lv_memset`. Writes bytes until `dest` is 16-byte
+ * aligned, then fills 64 bytes per iteration with aligned 128-bit stores
+ * of the broadcast byte, and finishes the tail byte by byte. Fills of
+ * `g_lv_nt_threshold` bytes or more use non-temporal stores for the
+ * bulk so they do not evict the cache.
  *
  * Parameters:
- * dest - A pointer to the destination memory region.
- * o    - The 8-bit value (byte) to write.
- * n    - A pointer to the remaining number of bytes to write. This value is decremented.
- * r    - A pointer to a `t_u8` that will store the alignment status from `_aligned`.
+ * dest - A pointer to the destination memory area.
+ * c    - The byte value to write (converted to `unsigned char`).
+ * n    - The number of bytes to set.
  *
  * Returns:
- * The number of bytes processed by this function to achieve alignment or exhaust `n`.
- *
- * Notes:
- * - This function is `always_inline` for performance critical paths.
- * - It updates `n` to reflect the bytes processed.
- * - `*r` is set by calls to `_aligned` to indicate if alignment has been achieved.
+ * A pointer to the destination memory area `dest`.
  */
 
-LV_INLINE inline size_t	_alinger(void *__restrict__ dest,
-	t_u8 o, size_t *n, t_u8 *r)
+LV_SSE2 void	*_lv_memset_sse2(void *__restrict__ dest, int c, size_t n)
 {
-	size_t	x;
+	t_u8	*d;
+	__m128i	v;
 
-	x = 0;
-	while (*n && !*r)
+	d = (t_u8 *)dest;
+	while (n && ((t_uptr)d & 15))
+	{
+		*d++ = (t_u8)c;
+		--n;
+	}
+	v = _mm_set1_epi8((char)c);
+	if (n >= g_lv_nt_threshold)
+	{
+		while (n >= 64)
+		{
+			_mm_stream_si128((__m128i *)d, v);
+			_mm_stream_si128((__m128i *)(d + 16), v);
+			_mm_stream_si128((__m128i *)(d + 32), v);
+			_mm_stream_si128((__m128i *)(d + 48), v);
+			d += 64;
+			n -= 64;
+		}
+		_mm_sfence();
+	}
+	while (n >= 64)
+	{
+		_mm_store_si128((__m128i *)d, v);
+		_mm_store_si128((__m128i *)(d + 16), v);
+		_mm_store_si128((__m128i *)(d + 32), v);
+		_mm_store_si128((__m128i *)(d + 48), v);
+		d += 64;
+		n -= 64;
+	}
+	while (n >= 16)
+	{
+		_mm_store_si128((__m128i *)d, v);
+		d += 16;
+		n -= 16;
+	}
+	while (n)
 	{
-		((t_u8 *)dest)[x] = o;
-		++x;
-		--(*n);
-		*r = _aligned((t_u8 *)dest, NULL, &x);
+		*d++ = (t_u8)c;
+		--n;
 	}
-	return (x);
+	return (dest);
+}
+
+/*
+ * Function: _lv_memset_avx2
+ * -------------------------
+ * AVX2 variant of `lv_memset`. Same structure as `_lv_memset_sse2`,
+ * with 32-byte alignment and 256-bit stores.
+ */
+
+LV_AVX2 void	*_lv_memset_avx2(void *__restrict__ dest, int c, size_t n)
+{
+	t_u8	*d;
+	__m256i	v;
+
+	d = (t_u8 *)dest;
+	while (n && ((t_uptr)d & 31))
+	{
+		*d++ = (t_u8)c;
+		--n;
+	}
+	v = _mm256_set1_epi8((char)c);
+	if (n >= g_lv_nt_threshold)
+	{
+		while (n >= 128)
+		{
+			_mm256_stream_si256((__m256i *)d, v);
+			_mm256_stream_si256((__m256i *)(d + 32), v);
+			_mm256_stream_si256((__m256i *)(d + 64), v);
+			_mm256_stream_si256((__m256i *)(d + 96), v);
+			d += 128;
+			n -= 128;
+		}
+		_mm_sfence();
+	}
+	while (n >= 128)
+	{
+		_mm256_store_si256((__m256i *)d, v);
+		_mm256_store_si256((__m256i *)(d + 32), v);
+		_mm256_store_si256((__m256i *)(d + 64), v);
+		_mm256_store_si256((__m256i *)(d + 96), v);
+		d += 128;
+		n -= 128;
+	}
+	while (n >= 32)
+	{
+		_mm256_store_si256((__m256i *)d, v);
+		d += 32;
+		n -= 32;
+	}
+	while (n)
+	{
+		*d++ = (t_u8)c;
+		--n;
+	}
+	return (dest);
+}
+
+/*
+ * Function: _lv_memset_avx512
+ * ---------------------------
+ * AVX-512 variant of `lv_memset`. Same structure as `_lv_memset_sse2`,
+ * with 64-byte alignment and 512-bit stores.
+ */
+
+LV_AVX512 void	*_lv_memset_avx512(void *__restrict__ dest, int c, size_t n)
+{
+	t_u8	*d;
+	__m512i	v;
+
+	d = (t_u8 *)dest;
+	while (n && ((t_uptr)d & 63))
+	{
+		*d++ = (t_u8)c;
+		--n;
+	}
+	v = _mm512_set1_epi8((char)c);
+	if (n >= g_lv_nt_threshold)
+	{
+		while (n >= 256)
+		{
+			_mm512_stream_si512((__m512i *)d, v);
+			_mm512_stream_si512((__m512i *)(d + 64), v);
+			_mm512_stream_si512((__m512i *)(d + 128), v);
+			_mm512_stream_si512((__m512i *)(d + 192), v);
+			d += 256;
+			n -= 256;
+		}
+		_mm_sfence();
+	}
+	while (n >= 256)
+	{
+		_mm512_store_si512(d, v);
+		_mm512_store_si512(d + 64, v);
+		_mm512_store_si512(d + 128, v);
+		_mm512_store_si512(d + 192, v);
+		d += 256;
+		n -= 256;
+	}
+	while (n >= 64)
+	{
+		_mm512_store_si512(d, v);
+		d += 64;
+		n -= 64;
+	}
+	while (n)
+	{
+		*d++ = (t_u8)c;
+		--n;
+	}
+	return (dest);
 }
 
 /*
@@ -74,32 +211,14 @@ LV_INLINE inline size_t	_alinger(void *__restrict__ dest,
  * A pointer to the destination memory area `dest`.
  *
  * Notes:
- * - This function is optimized to handle initial unaligned bytes and then
- * transition to word-sized writes (32-bit, 64-bit, 128-bit) if alignment
- * is achieved, falling back to byte-wise write for any remaining bytes.
- * - It uses `populate` to create a repeated byte mask for word-sized writes.
- * - It uses helper functions `_alinger`, `_write_u8_fwd`, `_write_u32_fwd`,
- * `_write_u64_fwd`, and `_write_u128_fwd` for efficient filling.
+ * - The fill is done by the SSE2, AVX2 or AVX-512 variant picked at
+ * load time by `lv_cpu_dispatch`.
+ * - Fills larger than `g_lv_nt_threshold` are streamed past the cache.
  */
 
-LV_SIMD LV_INLINE_HOT inline void	*lv_memset(void *__restrict__ dest, int c, size_t n)
+LV_HOT void	*lv_memset(void *__restrict__ dest, int c, size_t n)
 {
-	size_t	i;
-	t_u8	r;
-	t_u64	x;
-
 	if ((!dest) && n != 0)
 		return (NULL);
-	x = __populate(c);
-	r = _aligned((t_u8 *)dest, NULL, &x);
-	i = _alinger(dest, (t_u8)x, &n, &r);
-	if (n >= sizeof(t_u128) * 2 && r == 128)
-		_write_u128_fwd((t_u8 *)dest, x, &n, &i);
-	else if (n >= sizeof(t_u64) * 2 && r >= 64)
-		_write_u64_fwd((t_u8 *)dest, (t_u64)x, &n, &i);
-	else if (n >= sizeof(t_u32) * 2 && r >= 32)
-		_write_u32_fwd((t_u8 *)dest, (t_u32)x, &n, &i);
-	if (n > 0)
-		_write_u8_fwd((t_u8 *)dest, (t_u8)x, &n, &i);
-	return (dest);
+	return (g_lv_mem.set(dest, c, n));
 }
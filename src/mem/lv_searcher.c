@@ -0,0 +1,222 @@
+/**
+ * lv_searcher.c
+ *
+ * Copyright (C) 2025 lvzrr <lvzrr@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General
+ * Public License along with this program. If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#include "mem.h"
+
+/*
+ * Function: _max_suffix
+ * ---------------------
+ * Computes the maximal suffix of `nd` for the byte order selected by
+ * `rev` and its period. Returns the position just before the suffix
+ * starts (`(size_t)-1` for the whole needle) and stores the period in
+ * `*period`.
+ */
+
+static size_t	_max_suffix(const t_u8 *nd, size_t len, bool rev,
+	size_t *period)
+{
+	size_t	ip;
+	size_t	jp;
+	size_t	k;
+	size_t	p;
+
+	ip = (size_t)-1;
+	jp = 0;
+	k = 1;
+	p = 1;
+	while (jp + k < len)
+	{
+		if (nd[ip + k] == nd[jp + k])
+		{
+			if (k == p)
+			{
+				jp += p;
+				k = 1;
+			}
+			else
+				k++;
+		}
+		else if ((nd[ip + k] > nd[jp + k]) ^ rev)
+		{
+			jp += k;
+			k = 1;
+			p = jp - ip;
+		}
+		else
+		{
+			ip = jp++;
+			k = p = 1;
+		}
+	}
+	*period = p;
+	return (ip);
+}
+
+/*
+ * Function: lv_searcher_init
+ * --------------------------
+ * Precompiles a needle so that it can be searched for in any number of
+ * haystacks without paying the setup again.
+ *
+ * Parameters:
+ * s      - The searcher to fill.
+ * needle - The bytes to search for.
+ * len    - The length of `needle`.
+ *
+ * Returns:
+ * None.
+ *
+ * Notes:
+ * - `needle` is not copied: it must outlive the searcher.
+ * - Needles longer than `LV_SEARCH_SHORT` get a Two-Way critical
+ * factorization (`ms`, `period`, `mem0`) and a bad character table
+ * (`shift`) holding, for every byte, how far the window can move when
+ * that byte is under the needle's last position. Shorter needles need
+ * none of it and are set up in constant time.
+ */
+
+void	lv_searcher_init(t_searcher *s, const void *needle, size_t len)
+{
+	const t_u8	*nd;
+	size_t		p0;
+	size_t		p;
+	size_t		ms;
+	size_t		i;
+
+	if (!s)
+		return ;
+	nd = (const t_u8 *)needle;
+	s->needle = nd;
+	s->len = nd ? len : 0;
+	if (s->len <= LV_SEARCH_SHORT)
+		return ;
+	i = 0;
+	while (i < 256)
+		s->shift[i++] = len;
+	i = 0;
+	while (i < len)
+	{
+		s->shift[nd[i]] = len - i - 1;
+		i++;
+	}
+	ms = _max_suffix(nd, len, false, &p0);
+	i = _max_suffix(nd, len, true, &p);
+	if (i + 1 > ms + 1)
+		ms = i;
+	else
+		p = p0;
+	s->ms = ms;
+	s->period = p;
+	s->mem0 = len - p;
+	if (!lv_memeq(nd, nd + p, ms + 1))
+	{
+		s->period = LV_MAX(ms + 1, len - ms - 1) + 1;
+		s->mem0 = 0;
+	}
+}
+
+/*
+ * Function: _two_way
+ * ------------------
+ * The Two-Way search proper. Every window is first checked on its last
+ * byte through the shift table, then the right half of the
+ * factorization is compared left to right and the left half right to
+ * left. For periodic needles `mem` remembers how much of the window is
+ * already known to match, which keeps the whole scan linear.
+ */
+
+static void	*_two_way(const t_searcher *s, const t_u8 *h, size_t n)
+{
+	const t_u8	*end;
+	const t_u8	*nd;
+	size_t		l;
+	size_t		mem;
+	size_t		k;
+
+	nd = s->needle;
+	l = s->len;
+	end = h + (n - l);
+	mem = 0;
+	while (h <= end)
+	{
+		k = s->shift[h[l - 1]];
+		if (k)
+		{
+			if (s->mem0 && mem && k < s->period)
+				k = l - s->period;
+			h += k;
+			mem = 0;
+			continue ;
+		}
+		k = LV_MAX(s->ms + 1, mem);
+		while (k < l && nd[k] == h[k])
+			k++;
+		if (k < l)
+		{
+			h += k - s->ms;
+			mem = 0;
+			continue ;
+		}
+		k = s->ms + 1;
+		while (k > mem && nd[k - 1] == h[k - 1])
+			k--;
+		if (k <= mem)
+			return ((void *)h);
+		h += s->period;
+		mem = s->mem0;
+	}
+	return (NULL);
+}
+
+/*
+ * Function: lv_searcher_find
+ * --------------------------
+ * Finds the first occurrence of a precompiled needle in `hay`.
+ *
+ * Parameters:
+ * s   - A searcher built by `lv_searcher_init`.
+ * hay - The memory area to be searched.
+ * n   - The number of bytes in `hay`.
+ *
+ * Returns:
+ * A pointer to the first occurrence, `hay` if the needle is empty, or
+ * NULL if there is none (or if `s` or `hay` is NULL).
+ *
+ * Notes:
+ * - Short needles use the same SIMD filter as `lv_memmem`; long ones
+ * run Two-Way, O(n) time and O(1) extra space, with no per-call setup.
+ * - The searcher is only read, so one of them can be shared by several
+ * threads.
+ */
+
+void	*lv_searcher_find(const t_searcher *s, const void *hay, size_t n)
+{
+	if (!s)
+		return (NULL);
+	if (!s->len)
+		return ((void *)hay);
+	if (!hay || s->len > n)
+		return (NULL);
+	if (s->len == 1)
+		return (lv_memchr(hay, *s->needle, n));
+	if (s->len <= LV_SEARCH_SHORT)
+		return (g_lv_mem.find(hay, n, s->needle, s->len));
+	return (_two_way(s, (const t_u8 *)hay, n));
+}
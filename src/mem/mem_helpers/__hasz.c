@@ -39,7 +39,7 @@
 
 LV_INLINE inline int	__hasz64(t_u64 x)
 {
-    return (((x) -LONES_64) & (~x) & HIGHS_64);
+    return ((((x) - LONES_64) & (~x) & HIGHS_64) != 0);
 }
 
 /*
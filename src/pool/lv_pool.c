@@ -0,0 +1,389 @@
+/**
+ * lv_pool.c
+ *
+ * Copyright (C) 2025 lvzrr <lvzrr@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General
+ * Public License along with this program. If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#include "pool.h"
+#include <unistd.h>
+
+/*
+ * Set while a thread runs pool tasks: a task calling `lv_pool_run`
+ * again runs the nested job inline instead of deadlocking on the pool.
+ */
+
+static __thread bool	g_in_pool;
+
+static t_pool			*g_default;
+static pthread_once_t	g_default_once = PTHREAD_ONCE_INIT;
+
+/*
+ * Function: _take
+ * ---------------
+ * Pops the next task index of queue `q`. Returns false when it is empty.
+ */
+
+static bool	_take(t_pool_queue *q, size_t *task)
+{
+	bool	ok;
+
+	pthread_mutex_lock(&q->lock);
+	ok = q->lo < q->hi;
+	if (ok)
+		*task = q->lo++;
+	pthread_mutex_unlock(&q->lock);
+	return (ok);
+}
+
+/*
+ * Function: _steal
+ * ----------------
+ * Looks for work in the other queues, starting after slot `self`, and
+ * moves the back half of the first non-empty range found to `self`.
+ * Returns false when every queue is empty.
+ */
+
+static bool	_steal(t_pool *pool, size_t self)
+{
+	t_pool_queue	*q;
+	size_t			i;
+	size_t			lo;
+	size_t			hi;
+
+	i = 1;
+	while (i <= pool->workers)
+	{
+		q = &pool->queues[(self + i) % (pool->workers + 1)];
+		pthread_mutex_lock(&q->lock);
+		hi = q->hi;
+		lo = q->lo + (q->hi - q->lo) / 2;
+		if (lo < hi)
+			q->hi = lo;
+		pthread_mutex_unlock(&q->lock);
+		if (lo < hi)
+		{
+			pthread_mutex_lock(&pool->queues[self].lock);
+			pool->queues[self].lo = lo;
+			pool->queues[self].hi = hi;
+			pthread_mutex_unlock(&pool->queues[self].lock);
+			return (true);
+		}
+		i++;
+	}
+	return (false);
+}
+
+/*
+ * Function: _work
+ * ---------------
+ * Runs tasks of the current job from slot `self` until no queue has any
+ * left. The participant finishing the last task wakes the caller.
+ */
+
+static void	_work(t_pool *pool, size_t self)
+{
+	size_t	task;
+
+	g_in_pool = true;
+	while (1)
+	{
+		while (_take(&pool->queues[self], &task))
+		{
+			pool->fn(task, pool->ctx);
+			if (__atomic_sub_fetch(&pool->pending, 1, __ATOMIC_ACQ_REL) == 0)
+			{
+				pthread_mutex_lock(&pool->lock);
+				pthread_cond_broadcast(&pool->done);
+				pthread_mutex_unlock(&pool->lock);
+			}
+		}
+		if (!_steal(pool, self))
+			break ;
+	}
+	g_in_pool = false;
+}
+
+/*
+ * Function: _worker
+ * -----------------
+ * Worker thread: sleeps until a job is posted, joins it if it still has
+ * tasks, and leaves once every queue is empty.
+ */
+
+static void	*_worker(void *arg)
+{
+	t_pool	*pool;
+	size_t	self;
+	size_t	seen;
+
+	pool = ((void **)arg)[0];
+	self = (size_t)((void **)arg)[1];
+	lv_free((void **)&arg);
+	seen = 0;
+	pthread_mutex_lock(&pool->lock);
+	while (1)
+	{
+		while (!pool->stop && pool->generation == seen)
+			pthread_cond_wait(&pool->wake, &pool->lock);
+		if (pool->stop)
+			break ;
+		seen = pool->generation;
+		if (!__atomic_load_n(&pool->pending, __ATOMIC_ACQUIRE))
+			continue ;
+		pool->active++;
+		pthread_mutex_unlock(&pool->lock);
+		_work(pool, self);
+		pthread_mutex_lock(&pool->lock);
+		if (!--pool->active)
+			pthread_cond_broadcast(&pool->done);
+	}
+	pthread_mutex_unlock(&pool->lock);
+	return (NULL);
+}
+
+/*
+ * Function: _spawn
+ * ----------------
+ * Starts worker `self`. Returns false if the thread could not be made.
+ */
+
+static bool	_spawn(t_pool *pool, size_t self)
+{
+	void	**arg;
+
+	arg = lv_alloc(2 * sizeof(void *));
+	if (!arg)
+		return (false);
+	arg[0] = pool;
+	arg[1] = (void *)self;
+	if (pthread_create(&pool->threads[self - 1], NULL, _worker, arg))
+	{
+		lv_free((void **)&arg);
+		return (false);
+	}
+	return (true);
+}
+
+/*
+ * Function: lv_pool_create
+ * ------------------------
+ * Creates a pool of worker threads.
+ *
+ * Parameters:
+ * threads - The number of threads running tasks, the caller of
+ * `lv_pool_run` included (so `threads - 1` workers are started). 0
+ * means one per online CPU.
+ * flags   - `LV_POOL_DETERMINISTIC` to start no worker at all and run
+ * every task on the caller, in order; 0 otherwise.
+ *
+ * Returns:
+ * The new pool, or NULL on failure.
+ *
+ * Notes:
+ * - Workers sleep on a condition variable between jobs.
+ * - Free it with `lv_pool_destroy`.
+ */
+
+t_pool	*lv_pool_create(size_t threads, int flags)
+{
+	t_pool	*pool;
+	long	cpus;
+
+	if (!threads)
+	{
+		cpus = sysconf(_SC_NPROCESSORS_ONLN);
+		threads = 1;
+		if (cpus > 1)
+			threads = (size_t)cpus;
+	}
+	if (flags & LV_POOL_DETERMINISTIC)
+		threads = 1;
+	pool = lv_calloc(1, sizeof(t_pool));
+	if (!pool)
+		return (NULL);
+	pool->flags = flags;
+	pool->queues = lv_calloc(threads, sizeof(t_pool_queue));
+	pool->threads = lv_calloc(threads, sizeof(pthread_t));
+	if (!pool->queues || !pool->threads)
+		return (lv_pool_destroy(pool), NULL);
+	pthread_mutex_init(&pool->lock, NULL);
+	pthread_mutex_init(&pool->run, NULL);
+	pthread_cond_init(&pool->wake, NULL);
+	pthread_cond_init(&pool->done, NULL);
+	while (pool->workers + 1 < threads)
+	{
+		pthread_mutex_init(&pool->queues[pool->workers + 1].lock, NULL);
+		if (!_spawn(pool, pool->workers + 1))
+			break ;
+		pool->workers++;
+	}
+	pthread_mutex_init(&pool->queues[0].lock, NULL);
+	return (pool);
+}
+
+/*
+ * Function: lv_pool_destroy
+ * -------------------------
+ * Stops and joins the workers of `pool`, then frees it.
+ *
+ * Parameters:
+ * pool - The pool to destroy, or NULL. No job may be running on it.
+ *
+ * Returns:
+ * None.
+ */
+
+void	lv_pool_destroy(t_pool *pool)
+{
+	size_t	i;
+
+	if (!pool)
+		return ;
+	if (pool->queues && pool->threads)
+	{
+		pthread_mutex_lock(&pool->lock);
+		pool->stop = true;
+		pthread_cond_broadcast(&pool->wake);
+		pthread_mutex_unlock(&pool->lock);
+		i = 0;
+		while (i < pool->workers)
+			pthread_join(pool->threads[i++], NULL);
+		i = 0;
+		while (i <= pool->workers)
+			pthread_mutex_destroy(&pool->queues[i++].lock);
+		pthread_mutex_destroy(&pool->lock);
+		pthread_mutex_destroy(&pool->run);
+		pthread_cond_destroy(&pool->wake);
+		pthread_cond_destroy(&pool->done);
+	}
+	lv_free((void **)&pool->queues);
+	lv_free((void **)&pool->threads);
+	lv_free((void **)&pool);
+}
+
+/*
+ * Function: _default_init / _default_fini
+ * ---------------------------------------
+ * One-time creation of the shared pool, and its teardown at exit.
+ */
+
+static void	_default_fini(void)
+{
+	lv_pool_destroy(g_default);
+	g_default = NULL;
+}
+
+static void	_default_init(void)
+{
+	g_default = lv_pool_create(0, 0);
+	if (g_default)
+		atexit(_default_fini);
+}
+
+/*
+ * Function: lv_pool_default
+ * -------------------------
+ * Returns the process wide pool, one thread per online CPU, created on
+ * first use. The lv_vec_par_* functions use it when passed NULL.
+ */
+
+t_pool	*lv_pool_default(void)
+{
+	pthread_once(&g_default_once, _default_init);
+	return (g_default);
+}
+
+/*
+ * Function: lv_pool_size
+ * ----------------------
+ * Returns the number of threads running the tasks of `pool`, its caller
+ * included (1 for a deterministic pool).
+ */
+
+size_t	lv_pool_size(const t_pool *pool)
+{
+	if (!pool)
+		return (1);
+	return (pool->workers + 1);
+}
+
+/*
+ * Function: lv_pool_run
+ * ---------------------
+ * Runs `fn(task, ctx)` for every task index in [0, tasks) on the pool,
+ * and returns once all of them are done.
+ *
+ * Parameters:
+ * pool  - The pool, or NULL for `lv_pool_default()`.
+ * tasks - The number of tasks.
+ * fn    - The task function.
+ * ctx   - An arbitrary pointer passed through to `fn`.
+ *
+ * Returns:
+ * None.
+ *
+ * Notes:
+ * - The indices are dealt out to the participants in contiguous ranges;
+ * the calling thread takes part. An idle participant steals the back
+ * half of another one's remaining range, so uneven tasks balance out
+ * while neighbouring tasks mostly stay on the same core.
+ * - Tasks must be independent: they run in no particular order, except
+ * on a deterministic pool, or when called from inside a task (nested
+ * jobs run inline, in order).
+ * - Concurrent calls on one pool run one job after the other.
+ */
+
+void	lv_pool_run(t_pool *pool, size_t tasks,
+	void (*fn)(size_t task, void *ctx), void *ctx)
+{
+	size_t	i;
+	size_t	n;
+
+	if (!pool)
+		pool = lv_pool_default();
+	if (!tasks || !fn)
+		return ;
+	if (!pool || !pool->workers || tasks == 1 || g_in_pool)
+	{
+		i = 0;
+		while (i < tasks)
+			fn(i++, ctx);
+		return ;
+	}
+	pthread_mutex_lock(&pool->run);
+	pthread_mutex_lock(&pool->lock);
+	n = pool->workers + 1;
+	i = 0;
+	while (i < n)
+	{
+		pool->queues[i].lo = tasks * i / n;
+		pool->queues[i].hi = tasks * (i + 1) / n;
+		i++;
+	}
+	pool->fn = fn;
+	pool->ctx = ctx;
+	__atomic_store_n(&pool->pending, tasks, __ATOMIC_RELEASE);
+	pool->generation++;
+	pthread_cond_broadcast(&pool->wake);
+	pthread_mutex_unlock(&pool->lock);
+	_work(pool, 0);
+	pthread_mutex_lock(&pool->lock);
+	while (__atomic_load_n(&pool->pending, __ATOMIC_ACQUIRE) || pool->active)
+		pthread_cond_wait(&pool->done, &pool->lock);
+	pthread_mutex_unlock(&pool->lock);
+	pthread_mutex_unlock(&pool->run);
+}
@@ -38,9 +38,14 @@
  * it points directly to the `t_string`'s internal buffer.
  * - The returned pointer remains valid only as long as the `t_string`
  * object itself is not modified (e.g., through reallocation or content changes).
+ * - For strings of up to LV_TSTR_SSO bytes it points inside the
+ * `t_string` itself, so it is also invalidated when the object is
+ * copied or goes out of scope.
  */
 
 const char	*lv_tstr_borrow(const t_string *str)
 {
-	return (str->data);
+	if (str->heap)
+		return (str->data);
+	return (str->sso);
 }
@@ -35,17 +35,16 @@
  * None.
  *
  * Notes:
- * - If `s` is NULL or `s->data` is NULL (meaning the string is not initialized
- * or has no allocated memory), the function performs no action.
+ * - If `s` is NULL, the function performs no action.
  * - It uses `lv_memset` to efficiently zero out the characters.
- * - The `alloc_size` of the string is preserved, allowing for new content
+ * - The capacity of the string is preserved, allowing for new content
  * to be added without immediate reallocation.
  */
 
 void	lv_tstr_clear(t_string *s)
 {
-	if (!s || !s->data)
+	if (!s)
 		return ;
-	lv_memset(s->data, 0, s->len);
+	lv_memset(_lv_tstr_ptr(s), 0, s->len);
 	s->len = 0;
 }
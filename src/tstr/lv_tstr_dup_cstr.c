@@ -33,13 +33,14 @@
  * Returns:
  * A newly allocated `char` pointer containing a copy of the `t_string`'s
  * internal buffer (including its null terminator and potentially unused capacity),
- * or NULL if `str` or `str->data` is NULL, or if memory allocation fails.
+ * or NULL if `str` is NULL, or if memory allocation fails.
  *
  * Notes:
- * - This function duplicates the entire allocated block (`str->alloc_size` bytes),
+ * - This function duplicates the entire buffer (LV_TSTR_SSO + 1 bytes for
+ * an inline string, `str->alloc_size` for a heap one),
  * not just the active string length (`str->len`). This means it will copy
  * any null terminators or zeroed-out memory that exists beyond the
- * current string content up to the `alloc_size`.
+ * current string content up to the end of the buffer.
  * - The caller is responsible for freeing the returned C-style string
  * using `lv_free` (or equivalent) when it's no longer needed to prevent memory leaks.
  * - It relies on `lv_memclone` for the actual memory duplication.
@@ -47,7 +48,7 @@
 
 char	*lv_tstr_dup_cstr(t_string *str)
 {
-	if (!str || !str->data)
+	if (!str)
 		return (NULL);
-	return (lv_memclone(str->data, str->alloc_size));
+	return (lv_memclone(_lv_tstr_ptr(str), _lv_tstr_cap(str)));
 }
@@ -34,10 +34,12 @@
  * None.
  *
  * Notes:
- * - If `str` is NULL, or if the string's `alloc_size` already perfectly matches
- * `str->len + 1`, the function does nothing.
- * - It uses `lv_realloc` to adjust the memory size. If `lv_realloc` fails,
- * the function returns without modifying the string's state.
+ * - If `str` is NULL, the string is stored inline, or its `alloc_size`
+ * already perfectly matches `str->len + 1`, the function does nothing.
+ * - A heap string short enough to be stored inline (LV_TSTR_SSO bytes)
+ * is moved back into the `t_string` and its buffer freed.
+ * - The content is copied to a new `len + 1` byte buffer. If that
+ * allocation fails, the function returns without modifying the string.
  * - After a successful fit, `str->alloc_size` will be `str->len + 1`.
  */
 
@@ -45,11 +47,21 @@ void	lv_tstr_fit(t_string *str)
 {
 	char	*new;
 
-	if (!str || str->len + 1 == str->alloc_size)
+	if (!str || !str->heap || str->len + 1 == str->alloc_size)
 		return ;
-	new = lv_realloc(str->data, str->alloc_size, str->len + 1);
+	if (str->len <= LV_TSTR_SSO)
+	{
+		new = str->data;
+		lv_memset(str->sso, 0, sizeof(str->sso));
+		lv_memcpy(str->sso, new, str->len);
+		lv_free((void **)&new);
+		return ;
+	}
+	new = lv_alloc(str->len + 1);
 	if (!new)
 		return ;
+	lv_memcpy(new, str->data, str->len + 1);
+	lv_free((void **)&str->data);
 	str->data = new;
 	str->alloc_size = str->len + 1;
 }
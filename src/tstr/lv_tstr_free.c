@@ -24,7 +24,7 @@
  * Function: lv_tstr_free
  * ----------------------
  * Deallocates the memory associated with a `t_string` object's data
- * and resets its internal state (`len`, `alloc_size`, `data`) to zero.
+ * and resets it to an empty inline string.
  * This function should be called when a `t_string` is no longer needed
  * to prevent memory leaks.
  *
@@ -35,22 +35,19 @@
  * None.
  *
  * Notes:
- * - It handles cases where `str->data` might already be NULL.
- * - It uses `lv_free` to deallocate the `data` pointer.
- * - After freeing, `str->data` is set to NULL, and `str->len` and
- * `str->alloc_size` are set to 0.
+ * - Only heap strings own memory; it is released with `lv_free`.
+ * - After freeing, the whole object is zeroed, which is a valid empty
+ * string: it can be pushed to again.
  */
 
 void	lv_tstr_free(t_string *str)
 {
 	void	*tmp;
 
-	if (str->data)
+	if (str->heap)
 	{
 		tmp = str->data;
 		lv_free(&tmp);
-		str->data = NULL;
 	}
-	str->len = 0;
-	str->alloc_size = 0;
+	*str = (t_string){0};
 }
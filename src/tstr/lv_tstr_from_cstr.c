@@ -32,35 +32,18 @@
  *
  * Returns:
  * A new `t_string` object containing the copied string data.
- * If `str` is NULL, it returns an empty `t_string` with a single null byte allocated.
- * If memory allocation fails, it returns an empty `t_string` with `data` set to NULL.
+ * If `str` is NULL, or memory allocation fails, it returns an empty
+ * `t_string`.
  *
  * Notes:
  * - It calculates the length of the input string using `lv_strlen`.
- * - It allocates `len + 1` bytes to accommodate the string content plus the null terminator.
- * - The allocated memory is zeroed out using `lv_memset` before copying the string.
- * - It uses `lv_alloc` for initial allocation and `lv_memcpy` for copying the data.
+ * - See `lv_tstr_from_slice`: strings of up to LV_TSTR_SSO bytes are
+ * stored inline, longer ones get a zeroed buffer of `len + 1` bytes.
  */
 
 t_string	lv_tstr_from_cstr(const char *str)
 {
-	t_string	out;
-
 	if (!str)
-	{
-		out.len = 0;
-		out.alloc_size = 1;
-		out.data = lv_alloc(1);
-		lv_memset(out.data, 0, 1);
-	}
-	else
-	{
-		out.len = lv_strlen(str);
-		out.alloc_size = out.len + 1;
-		out.data = lv_alloc(out.alloc_size);
-		lv_memset(out.data, 0, out.alloc_size);
-		if (out.data)
-			lv_memcpy(out.data, str, out.len);
-	}
-	return (out);
+		return ((t_string){0});
+	return (lv_tstr_from_slice((char *)str, lv_strlen(str)));
 }
@@ -20,25 +20,32 @@
 
 #include "tstr.h"
 
-t_string lv_tstr_from_slice(char *s, size_t n)
+/*
+ * Function: lv_tstr_from_slice
+ * ----------------------------
+ * Creates a new `t_string` holding a copy of the first `n` bytes of `s`.
+ *
+ * Parameters:
+ * s - The bytes to copy.
+ * n - The number of bytes to copy.
+ *
+ * Returns:
+ * The new `t_string`. If `s` is NULL, or memory allocation fails, it
+ * returns an empty `t_string`.
+ *
+ * Notes:
+ * - Up to LV_TSTR_SSO bytes are stored inline, without allocating.
+ * - Longer slices get a zeroed buffer of `n + 1` bytes.
+ */
+
+t_string	lv_tstr_from_slice(char *s, size_t n)
 {
 	t_string	out;
 
-	if (!s)
-	{
-		out.len = 0;
-		out.alloc_size = 1;
-		out.data = lv_alloc(1);
-		lv_memset(out.data, 0, 1);
-	}
-	else
-	{
-		out.len = n;
-		out.alloc_size = out.len + 1;
-		out.data = lv_memclone(s, out.len);
-		lv_memset(out.data, 0, out.alloc_size);
-		if (out.data)
-			lv_memcpy(out.data, s, out.len);
-	}
+	out = (t_string){0};
+	if (!s || !_lv_tstr_grow(&out, n + 1))
+		return (out);
+	lv_memcpy(_lv_tstr_ptr(&out), s, n);
+	out.len = n;
 	return (out);
 }
@@ -0,0 +1,72 @@
+/**
+ * lv_tstr_grow.c
+ *
+ * Copyright (C) 2025 lvzrr <lvzrr@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General
+ * Public License along with this program. If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#include "tstr.h"
+#include <stddef.h>
+
+_Static_assert(offsetof(t_string, heap) == offsetof(t_string, sso)
+	+ LV_TSTR_SSO, "t_string: heap must overlap the last byte of sso");
+
+/*
+ * Function: _lv_tstr_grow
+ * -----------------------
+ * Makes sure `str` has room for `size` bytes, null terminator included,
+ * moving an inline string to the heap when it no longer fits.
+ *
+ * Parameters:
+ * str  - A pointer to the `t_string` object.
+ * size - The capacity needed, in bytes.
+ *
+ * Returns:
+ * true on success, false if the allocation failed (`str` is then left
+ * untouched).
+ *
+ * Notes:
+ * - The capacity of a non-empty string at least doubles, so appending
+ * is amortized O(1). An empty one gets exactly `size` bytes, which is
+ * what `lv_tstr_new` and `lv_tstr_from_slice` ask for.
+ * - New bytes are zeroed, keeping everything past `len` zero.
+ */
+
+bool	_lv_tstr_grow(t_string *str, size_t size)
+{
+	size_t	cap;
+	char	*new;
+
+	cap = _lv_tstr_cap(str);
+	if (size <= cap)
+		return (true);
+	if (str->len)
+		size = LV_MAX(size, cap * 2);
+	if (str->heap)
+		new = lv_extend_zero(str->data, cap, size - cap);
+	else
+	{
+		new = lv_calloc(size, 1);
+		if (new)
+			lv_memcpy(new, str->sso, str->len);
+	}
+	if (!new)
+		return (false);
+	str->data = new;
+	str->alloc_size = size;
+	str->heap = 1;
+	return (true);
+}
@@ -20,21 +20,41 @@
 
 #include "tstr.h"
 
+/*
+ * Function: lv_tstr_insert
+ * ------------------------
+ * Inserts the null-terminated string `insert` into `str` before the
+ * character at `position`.
+ *
+ * Parameters:
+ * str      - A pointer to the `t_string` object to insert into.
+ * insert   - The null-terminated string to insert.
+ * position - The index to insert at, from 0 to `str->len`.
+ *
+ * Returns:
+ * None.
+ *
+ * Notes:
+ * - If `str` or `insert` is NULL, `position` is past the end, or the
+ * string cannot grow, the function does nothing.
+ */
+
 void	lv_tstr_insert(t_string *str, const char *insert, size_t position)
 {
 	size_t	insert_len;
 	size_t	new_len;
+	char	*p;
 
-	if (!str || !str->data || !insert || position > str->len)
+	if (!str || !insert || position > str->len)
 		return ;
 	insert_len = lv_strlen(insert);
 	new_len = str->len + insert_len;
-	if (new_len + 1 > str->alloc_size)
-		lv_tstr_reserve(str, new_len);
-	lv_memmove(str->data + position + insert_len,
-		str->data + position,
+	if (!_lv_tstr_grow(str, new_len + 1))
+		return ;
+	p = _lv_tstr_ptr(str);
+	lv_memmove(p + position + insert_len, p + position,
 		str->len - position);
-	lv_memcpy(str->data + position, insert, insert_len);
+	lv_memcpy(p + position, insert, insert_len);
 	str->len = new_len;
-	str->data[str->len] = '\0';
+	p[str->len] = '\0';
 }
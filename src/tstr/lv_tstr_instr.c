@@ -21,49 +21,6 @@
 #include "cstr.h"
 #include "tstr.h"
 
-/*
- * Function: lv_find
- * -----------------
- * A static helper function to find the first occurrence of a `needle` string
- * within a `haystack` string, considering a maximum search length `n`.
- *
- * Parameters:
- * haystack - The string to search within.
- * needle   - The string to search for.
- * n        - The maximum number of bytes to search in `haystack`.
- * l        - The length of the `needle` string (passed as `l` for efficiency).
- *
- * Returns:
- * The zero-based index of the first occurrence of `needle` in `haystack`,
- * or -1 if `needle` is not found within `n` bytes.
- * Returns 0 if `needle` is an empty string.
- * Returns -1 if `haystack` is an empty string and `needle` is not empty.
- *
- * Notes:
- * - This function is designed to be used internally by `lv_tstr_instr`.
- * - It checks for initial characters and then uses `lv_strncmp` for full substring comparison.
- */
-
-static ssize_t	lv_find(const char *haystack, const char *needle, size_t n,
-							size_t l)
-{
-	size_t	i;
-
-	i = 0;
-	l = 0;
-	if (!*needle)
-		return (0);
-	if (!*haystack)
-		return (-1);
-	while (haystack[i] && (i + l) <= n)
-	{
-		if (haystack[i] == needle[0] && !lv_strncmp(&(haystack[i]), needle, l))
-			return ((ssize_t) i);
-		i++;
-	}
-	return (-1);
-}
-
 /*
  * Function: lv_tstr_instr
  * -----------------------
@@ -76,19 +33,24 @@ static ssize_t	lv_find(const char *haystack, const char *needle, size_t n,
  *
  * Returns:
  * The zero-based index of the first occurrence of `n` in `h`,
- * or -1 if `h`, `h->data`, or `n` is NULL, or if `n` is not found.
+ * or -1 if `h` or `n` is NULL, or if `n` is not found.
+ * Returns 0 if `n` is an empty string.
  *
  * Notes:
- * - It calculates the length of the `needle` string (`n`) once for efficiency.
- * - It delegates the actual search logic to the internal `lv_find` helper function.
+ * - The whole `h->len` bytes are searched with `lv_memmem`; the string's
+ * own length is used, so embedded null bytes do not cut the search short.
+ * - To search many strings for the same needle, build a `t_searcher`
+ * once and call `lv_searcher_find` on `lv_tstr_borrow(h)` directly.
  */
 
 ssize_t	lv_tstr_instr(const t_string *h, const char *n)
 {
-	size_t	l;
+	const char	*hit;
 
-	if (!h ||!h->data || !n)
+	if (!h || !n)
+		return (-1);
+	hit = lv_memmem(lv_tstr_borrow(h), h->len, n, lv_strlen(n));
+	if (!hit)
 		return (-1);
-	l = lv_strlen(n);
-	return (lv_find(lv_tstr_borrow(h), n, h->len, l));
+	return ((ssize_t)(hit - lv_tstr_borrow(h)));
 }
@@ -31,31 +31,24 @@
  * excluding the null terminator. The actual allocated size will be `len + 1`.
  *
  * Returns:
- * A new `t_string` object with allocated memory and `len` set to 0.
- * If `len` is negative or memory allocation fails, it returns an empty `t_string`
- * with `data` set to NULL and all other members set to 0.
+ * A new `t_string` object with `len` set to 0.
+ * If `len` is negative or memory allocation fails, it returns an empty
+ * inline string, as if `len` were 0.
  *
  * Notes:
- * - It allocates `len + 1` bytes and initializes them to zero using `lv_calloc`,
- * ensuring the string is null-terminated even when empty.
- * - The `alloc_size` will be `len + 1`.
+ * - Capacities of up to LV_TSTR_SSO bytes are stored inline in the
+ * `t_string` and allocate nothing.
+ * - Otherwise it allocates `len + 1` bytes and initializes them to zero
+ * using `lv_calloc`, ensuring the string is null-terminated even when
+ * empty. The `alloc_size` will be `len + 1`.
  */
 
 t_string	lv_tstr_new(ssize_t len)
 {
 	t_string	out;
 
-	if (len < 0)
-	{
-		out.len = 0;
-		out.alloc_size = 0;
-		out.data = NULL;
-		return (out);
-	}
-	out.len = 0;
-	out.alloc_size = (size_t) len + 1;
-	out.data = lv_calloc(out.alloc_size, 1);
-	if (!out.data)
-		out = (t_string){0};
+	out = (t_string){0};
+	if (len > LV_TSTR_SSO)
+		_lv_tstr_grow(&out, (size_t)len + 1);
 	return (out);
 }
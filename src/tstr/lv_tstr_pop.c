@@ -31,23 +31,25 @@
  *
  * Returns:
  * The character that was removed from the end of the string, or 0 (null character)
- * if `str` is NULL, `str->data` is NULL, or the string is empty.
+ * if `str` is NULL or the string is empty.
  *
  * Notes:
  * - The function retrieves the last character, then sets the new last character
  * (which was previously the second to last) to null (`\0`) to maintain null-termination,
  * and decrements `str->len`.
- * - The allocated capacity (`str->alloc_size`) remains unchanged.
+ * - The capacity remains unchanged.
  */
 
 char	lv_tstr_pop(t_string *str)
 {
+	char	*p;
 	char	o;
 
-	if (!str || !str->data || !str->len)
+	if (!str || !str->len)
 		return (0);
-	o = lv_tstr_borrow(str)[str->len - 1];
-	str->data[str->len - 1] = 0;
+	p = _lv_tstr_ptr(str);
+	o = p[str->len - 1];
+	p[str->len - 1] = 0;
 	str->len--;
 	return (o);
 }
@@ -36,28 +36,24 @@
  *
  * Notes:
  * - If `str` is NULL, the function does nothing.
- * - If the current `alloc_size` is not enough to hold the new character
- * and the null terminator (`str->len + 1 < str->alloc_size`), the data
- * is directly appended.
- * - Otherwise, the capacity is doubled using `lv_extend_zero` to make space.
- * - The new character is placed at `str->data[str->len]`, `str->len` is
+ * - If the current capacity is enough to hold the new character and the
+ * null terminator, the data is directly appended.
+ * - Otherwise, the capacity is doubled (an inline string moves to the
+ * heap). If that fails, the string is left unchanged.
+ * - The new character is placed at index `str->len`, `str->len` is
  * incremented, and a null terminator is placed at the new end.
  */
 
 void	lv_tstr_push(t_string *str, char c)
 {
+	char	*p;
+
 	if (!str)
 		return ;
-	if (str->len + 1 < str->alloc_size)
-	{
-		str->data[str->len++] = c;
-		str->data[str->len] = 0;
-		return ;
-	}
-	str->data = lv_extend_zero(str->data, str->alloc_size, str->alloc_size * 2);
-	str->alloc_size *= 2;
-	if (!str->data)
+	if (str->len + 1 >= _lv_tstr_cap(str)
+		&& !_lv_tstr_grow(str, str->len + 2))
 		return ;
-	str->data[str->len++] = c;
-	str->data[str->len] = 0;
+	p = _lv_tstr_ptr(str);
+	p[str->len++] = c;
+	p[str->len] = 0;
 }
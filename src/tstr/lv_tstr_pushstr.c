@@ -35,61 +35,45 @@
  *
  * Notes:
  * - If `str` or `s` is NULL, the function does nothing.
- * - It calculates the total length needed for the appended string plus null terminator.
- * - If `needed` length exceeds `str->alloc_size`, the capacity is expanded.
- * The new allocation size is `needed` itself, ensuring just enough space for the current content.
- * - It uses `lv_extend_zero` for reallocation and `lv_memmove` as a helper
- * for copying the string data.
- * - The `len` of the `t_string` is updated after successful append.
+ * - Same as `lv_tstr_pushslice` with the length of `s`.
  */
 
 void	lv_tstr_pushstr(t_string *str, const char *s)
 {
-	size_t	len;
-	size_t	needed;
-	char	*new_data;
-
 	if (!str || !s)
 		return ;
-	len = lv_strlen(s);
-	needed = str->len + len + 1;
-	if (needed > str->alloc_size)
-	{
-		new_data = lv_extend_zero(str->data, str->alloc_size,
-				(needed - str->alloc_size) * 2);
-		if (!new_data)
-			return ;
-		lv_memmove(new_data, str->data, str->len);
-		str->data = new_data;
-		str->alloc_size = needed;
-	}
-	lv_memmove(str->data + str->len, s, len);
-	str->len += len;
-	str->data[str->len] = 0;
+	lv_tstr_pushslice(str, s, lv_strlen(s));
 }
 
+/*
+ * Function: lv_tstr_pushslice
+ * ---------------------------
+ * Appends the first `n` bytes of `s` to the end of a `t_string` object.
+ *
+ * Parameters:
+ * str - A pointer to the `t_string` object to append to.
+ * s   - The bytes to append.
+ * n   - The number of bytes to append.
+ *
+ * Returns:
+ * None.
+ *
+ * Notes:
+ * - If `str` or `s` is NULL, the function does nothing.
+ * - While the result fits in LV_TSTR_SSO bytes it stays inline.
+ * Otherwise the capacity grows to at least twice its size, so repeated
+ * appends are amortized O(1). If that fails, the string is unchanged.
+ * - The `len` of the `t_string` is updated after successful append.
+ */
 
 void	lv_tstr_pushslice(t_string *str, const char *s, size_t n)
 {
-	size_t	len;
-	size_t	needed;
-	char	*new_data;
+	char	*p;
 
-	if (!str || !s)
+	if (!str || !s || !_lv_tstr_grow(str, str->len + n + 1))
 		return ;
-	len = n;
-	needed = str->len + len + 1;
-	if (needed > str->alloc_size)
-	{
-		new_data = lv_extend_zero(str->data, str->alloc_size,
-				(needed - str->alloc_size) * 2);
-		if (!new_data)
-			return ;
-		lv_memmove(new_data, str->data, str->len);
-		str->data = new_data;
-		str->alloc_size = needed;
-	}
-	lv_memmove(str->data + str->len, s, len);
-	str->len += len;
-	str->data[str->len] = 0;
+	p = _lv_tstr_ptr(str);
+	lv_memmove(p + str->len, s, n);
+	str->len += n;
+	p[str->len] = 0;
 }
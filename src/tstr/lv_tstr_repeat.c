@@ -37,8 +37,8 @@
  * Notes:
  * - If `str`, `chunk` is NULL, or `times` is 0, the function does nothing.
  * - It includes a check for integer overflow when calculating `total_len`.
- * - If the current `alloc_size` is insufficient, it reallocates the `t_string`'s
- * data to accommodate the total length of repetitions plus the null terminator.
+ * - If the current capacity is insufficient, the string grows to
+ * accommodate the total length of repetitions plus the null terminator.
  * - It uses `lv_memcpy` to efficiently copy the `chunk` multiple times.
  * - The `len` of the `t_string` is updated, and a null terminator is placed
  * at the new end of the string.
@@ -48,7 +48,7 @@ void	lv_tstr_repeat(t_string *str, const char *chunk, size_t times)
 {
 	size_t	chunk_len;
 	size_t	total_len;
-	char	*new_data;
+	char	*p;
 	size_t	i;
 
 	if (!str || !chunk || !times)
@@ -57,18 +57,12 @@ void	lv_tstr_repeat(t_string *str, const char *chunk, size_t times)
 	total_len = chunk_len * times;
 	if ((total_len / times) != chunk_len)
 		return ;
-	if (str->len + total_len + 1 > str->alloc_size)
-	{
-		new_data = lv_extend_zero(str->data, str->alloc_size,
-				str->len + total_len + 1);
-		if (!new_data)
-			return ;
-		str->data = new_data;
-		str->alloc_size = str->len + total_len + 1;
-	}
+	if (!_lv_tstr_grow(str, str->len + total_len + 1))
+		return ;
+	p = _lv_tstr_ptr(str);
 	i = 0;
 	while (i < times)
-		lv_memcpy(str->data + str->len + i++ *chunk_len, chunk, chunk_len);
+		lv_memcpy(p + str->len + i++ *chunk_len, chunk, chunk_len);
 	str->len += total_len;
-	str->data[str->len] = 0;
+	p[str->len] = 0;
 }
@@ -30,33 +30,24 @@
  *
  * Parameters:
  * str - A pointer to the `t_string` object for which to reserve space.
- * n   - The number of additional characters to reserve space for. This
- * includes the space for a potential null terminator if it's part of `n`.
+ * n   - The number of additional characters to reserve space for, on
+ * top of the null terminator.
  *
  * Returns:
  * None.
  *
  * Notes:
- * - If `str`, `str->data` is NULL, or `n` is 0, the function does nothing.
- * - If the current `alloc_size` is already greater than or equal to
- * `str->len + n`, no action is taken.
- * - It uses `lv_extend_zero` to reallocate the underlying buffer and
- * zero out any newly added space.
- * - The `alloc_size` of the string is increased by `n` after successful reservation.
+ * - If `str` is NULL, or `n` is 0, the function does nothing.
+ * - If the current capacity already holds `str->len + n + 1` bytes
+ * (inline strings hold LV_TSTR_SSO + 1), no action is taken.
+ * - Otherwise the string grows like on an append (see `_lv_tstr_grow`),
+ * moving to the heap if it was inline; new space is zeroed.
  * The `len` (actual string length) remains unchanged.
  */
 
 void	lv_tstr_reserve(t_string *str, size_t n)
 {
-	char	*new;
-
-	if (!str || !str->data || n == 0)
-		return ;
-	if (str->alloc_size >= str->len + n)
-		return ;
-	new = lv_extend_zero(str->data, str->alloc_size, n);
-	if (!new)
+	if (!str || n == 0)
 		return ;
-	str->data = new;
-	str->alloc_size += n;
+	_lv_tstr_grow(str, str->len + n + 1);
 }
@@ -20,37 +20,6 @@
 
 #include "tstr.h"
 
-/*
- * Function: in_set
- * ----------------
- * A static helper function to check if a given character `c` is present
- * within a null-terminated set of characters `set`.
- *
- * Parameters:
- * c   - The character to check.
- * set - A constant pointer to a null-terminated string representing the set of characters.
- *
- * Returns:
- * 1 if `c` is found in `set`, 0 otherwise.
- *
- * Notes:
- * - This function is designed to be used internally by `lv_tstr_trim`.
- */
-
-static int	in_set(const char c, const char *set)
-{
-	size_t	i;
-
-	i = 0;
-	while (set[i])
-	{
-		if (set[i] == c)
-			return (1);
-		i++;
-	}
-	return (0);
-}
-
 /*
  * Function: lv_tstr_trim
  * ----------------------
@@ -67,32 +36,37 @@ static int	in_set(const char c, const char *set)
  * None.
  *
  * Notes:
- * - If `str`, `str->data`, `str->len` is 0, or `set` is NULL, the function does nothing.
- * - It first identifies the `start` and `end` indices of the non-trimmed content.
+ * - If `str` is NULL, `str->len` is 0, or `set` is NULL, the function does nothing.
+ * - The set is turned into a `t_byteset` once, and the `start` and `end`
+ * of the kept content are found with `lv_memchr_not` / `lv_memrchr_not`,
+ * so each side is a single pass whatever the size of `set`.
  * - `lv_memmove` is used to shift the trimmed content to the beginning of the buffer.
- * - Any remaining space in the buffer after trimming is zeroed out using `lv_memset`.
+ * - The bytes freed at the end of the content are zeroed out using `lv_memset`.
  * - The `len` of the `t_string` is updated to reflect the new length.
- * - The `alloc_size` remains unchanged, but the string's content is effectively
+ * - The capacity remains unchanged, but the string's content is effectively
  * shortened and its data shifted.
  */
 
 void	lv_tstr_trim(t_string *str, const char *set)
 {
-	size_t	start;
-	size_t	end;
-	size_t	new_len;
+	t_byteset	bs;
+	char		*p;
+	char		*start;
+	char		*end;
+	size_t		new_len;
 
-	if (!str || !str->data || !str->len || !set)
+	if (!str || !str->len || !set)
 		return ;
-	start = 0;
-	end = str->len;
-	while (start < end && in_set(str->data[start], set))
-		start++;
-	while (end > start && in_set(str->data[end - 1], set))
-		end--;
-	new_len = end - start;
-	lv_memmove(str->data, str->data + start, new_len);
-	if (str->alloc_size > new_len)
-		lv_memset(str->data + new_len, 0, str->alloc_size - new_len);
+	p = _lv_tstr_ptr(str);
+	lv_byteset_init(&bs, set, lv_strlen(set));
+	start = lv_memchr_not(p, str->len, &bs);
+	new_len = 0;
+	if (start)
+	{
+		end = lv_memrchr_not(start, str->len - (size_t)(start - p), &bs);
+		new_len = (size_t)(end - start) + 1;
+		lv_memmove(p, start, new_len);
+	}
+	lv_memset(p + new_len, 0, str->len - new_len);
 	str->len = new_len;
 }
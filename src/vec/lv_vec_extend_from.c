@@ -0,0 +1,60 @@
+/**
+ * lv_vec_extend_from.c
+ *
+ * Copyright (C) 2025 lvzrr <lvzrr@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General
+ * Public License along with this program. If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#include "vec.h"
+
+/*
+ * Function: lv_vec_extend_from
+ * ----------------------------
+ * Appends every element of `src` to the end of `v`.
+ *
+ * Parameters:
+ * v   - A pointer to the `t_vec` structure to append to.
+ * src - A pointer to the vector whose elements are appended. It may be
+ * `v` itself.
+ *
+ * Returns:
+ * None.
+ *
+ * Notes:
+ * - Does nothing if either vector is NULL, `src` is empty, or the
+ * element sizes differ. An empty, zero-initialized `v` takes the
+ * element size of `src`.
+ * - The capacity grows at most once (`_lv_vec_grow`), and the elements
+ * are copied with a single `lv_memcpy`.
+ */
+
+void	lv_vec_extend_from(t_vec *v, const t_vec *src)
+{
+	size_t	len;
+
+	if (!v || !src || !src->size)
+		return ;
+	if (!v->sizeof_type && !v->alloc_size)
+		v->sizeof_type = src->sizeof_type;
+	if (v->sizeof_type != src->sizeof_type)
+		return ;
+	len = src->size;
+	if (!_lv_vec_grow(v, len))
+		return ;
+	lv_memcpy((t_u8 *)v->data + v->size * v->sizeof_type,
+		src->data, len * v->sizeof_type);
+	v->size += len;
+}
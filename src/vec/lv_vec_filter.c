@@ -0,0 +1,103 @@
+/**
+ * lv_vec_filter.c
+ *
+ * Copyright (C) 2025 lvzrr <lvzrr@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General
+ * Public License along with this program. If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#include "vec.h"
+
+/*
+ * Function: _filter_w
+ * -------------------
+ * Compacts the `n` elements of `base` that `keep` accepts to its front
+ * and returns their count. Inlined with a constant `w` for the common
+ * element sizes, where each move is a single load and store.
+ */
+
+LV_INLINE static inline size_t	_filter_w(t_u8 *base, size_t n, size_t w,
+	bool (*keep)(const void *, void *), void *ctx)
+{
+	t_u8	*src;
+	t_u8	*dst;
+	t_u8	*end;
+
+	src = base;
+	dst = base;
+	end = base + n * w;
+	while (src < end)
+	{
+		if (keep(src, ctx))
+		{
+			if (dst != src)
+			{
+				if (__builtin_constant_p(w) && w <= 8)
+					__builtin_memcpy(dst, src, w);
+				else
+					lv_memcpy(dst, src, w);
+			}
+			dst += w;
+		}
+		src += w;
+	}
+	return ((size_t)(dst - base) / w);
+}
+
+/*
+ * Function: lv_vec_filter
+ * -----------------------
+ * Removes from the vector `v` every element `keep` rejects, keeping the
+ * order of the others (in-place compaction).
+ *
+ * Parameters:
+ * v    - A pointer to the `t_vec` structure to filter.
+ * keep - The predicate, called as `keep(elem, ctx)`; elements for which
+ * it returns false are removed.
+ * ctx  - An arbitrary pointer passed through to `keep`.
+ *
+ * Returns:
+ * The number of elements removed.
+ *
+ * Notes:
+ * - If `v` or `keep` is NULL, the function does nothing and returns 0.
+ * - One pass, no allocation; the capacity is kept (see `lv_vec_fit`).
+ * - The slots freed at the end are zeroed, as `lv_vec_pop` does.
+ */
+
+size_t	lv_vec_filter(t_vec *v, bool (*keep)(const void *elem, void *ctx),
+	void *ctx)
+{
+	size_t	n;
+	size_t	w;
+
+	if (!v || !keep || !v->size)
+		return (0);
+	w = v->sizeof_type;
+	if (w == 1)
+		n = _filter_w(v->data, v->size, 1, keep, ctx);
+	else if (w == 2)
+		n = _filter_w(v->data, v->size, 2, keep, ctx);
+	else if (w == 4)
+		n = _filter_w(v->data, v->size, 4, keep, ctx);
+	else if (w == 8)
+		n = _filter_w(v->data, v->size, 8, keep, ctx);
+	else
+		n = _filter_w(v->data, v->size, w, keep, ctx);
+	lv_bzero((t_u8 *)v->data + n * w, (v->size - n) * w);
+	n = v->size - n;
+	v->size -= n;
+	return (n);
+}
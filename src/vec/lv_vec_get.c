@@ -31,21 +31,23 @@
  *
  * Returns:
  * A constant `void` pointer to the element at `idx` if successful,
- * or NULL if `vec` is invalid, the vector is empty, or `idx` is out of bounds.
+ * or NULL if `vec` is NULL or `idx` is out of bounds (`idx >= size`).
  *
  * Notes:
  * - The returned pointer is constant, meaning the data it points to
  * should not be modified directly. Use `lv_vec_get_mut` for mutable access.
  * - The index `idx` is zero-based.
+ * - In loops where the index is known to be in range, `LV_VEC_AT` and
+ * `LV_VEC_FOREACH` skip the checks.
  */
 
-const void	*lv_vec_get(t_vec *vec, size_t idx)
+const void	*lv_vec_get(const t_vec *vec, size_t idx)
 {
-	t_u8	*raw;
+	const t_u8	*raw;
 
-	if (!vec || !vec->size || idx > vec->size)
+	if (!vec || idx >= vec->size)
 		return (NULL);
-	raw = (t_u8 *)vec->data;
+	raw = (const t_u8 *)vec->data;
 	return (raw + (vec->sizeof_type * idx));
 }
 
@@ -60,7 +62,7 @@ const void	*lv_vec_get(t_vec *vec, size_t idx)
  *
  * Returns:
  * A mutable `void` pointer to the element at `idx` if successful,
- * or NULL if `vec` is invalid, the vector is empty, or `idx` is out of bounds.
+ * or NULL if `vec` is NULL or `idx` is out of bounds (`idx >= size`).
  *
  * Notes:
  * - The returned pointer allows direct modification of the element's data.
@@ -71,7 +73,7 @@ void	*lv_vec_get_mut(t_vec *vec, size_t idx)
 {
 	t_u8	*raw;
 
-	if (!vec || !vec->size || idx > vec->size)
+	if (!vec || idx >= vec->size)
 		return (NULL);
 	raw = (t_u8 *)vec->data;
 	return (raw + (vec->sizeof_type * idx));
@@ -89,7 +91,7 @@ void	*lv_vec_get_mut(t_vec *vec, size_t idx)
  *
  * Returns:
  * A `void` pointer to the newly allocated and copied element if successful,
- * or NULL if `vec` is invalid, the vector is empty, `idx` is out of bounds,
+ * or NULL if `vec` is NULL, `idx` is out of bounds (`idx >= size`),
  * or memory allocation for the clone fails.
  *
  * Notes:
@@ -104,7 +106,7 @@ void	*lv_vec_get_clone(t_vec *vec, size_t idx)
 {
 	t_u8	*raw;
 
-	if (!vec || !vec->size || idx > vec->size)
+	if (!vec || idx >= vec->size)
 		return (NULL);
 	raw = (t_u8 *)vec->data;
 	return(lv_memclone(raw + (vec->sizeof_type * idx),
@@ -0,0 +1,66 @@
+/**
+ * lv_vec_grow.c
+ *
+ * Copyright (C) 2025 lvzrr <lvzrr@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General
+ * Public License along with this program. If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#include "vec.h"
+
+/*
+ * Function: _lv_vec_grow
+ * ----------------------
+ * Makes room for `len` more elements in `vec`. Shared slow path of
+ * `lv_vec_push` and of the typed vectors (`LV_VEC_DECL`).
+ *
+ * Parameters:
+ * vec - The vector to grow; its `sizeof_type` must be set.
+ * len - The number of elements about to be appended.
+ *
+ * Returns:
+ * true if `vec` can hold `vec->size + len` elements, false on overflow
+ * or allocation failure (the vector is then unchanged).
+ *
+ * Notes:
+ * - The capacity grows by LV_VEC_GROWTH percent, or to exactly what is
+ * needed if that is more, so n appends cost O(n) in total.
+ * - The buffer grows with `lv_extend`, in place whenever the allocator
+ * can; only the `size` live elements are ever copied, and the new
+ * capacity is left uninitialized.
+ */
+
+bool	_lv_vec_grow(t_vec *vec, size_t len)
+{
+	void	*tmp;
+	size_t	new_alloc;
+
+	if (vec->size + len <= vec->alloc_size)
+		return (true);
+	if (len > SIZE_MAX - vec->size)
+		return (false);
+	new_alloc = vec->size + len;
+	if (vec->alloc_size <= SIZE_MAX / LV_VEC_GROWTH)
+		new_alloc = LV_MAX(vec->alloc_size * LV_VEC_GROWTH / 100, new_alloc);
+	if (!vec->sizeof_type || new_alloc > SIZE_MAX / vec->sizeof_type)
+		return (false);
+	tmp = lv_extend(vec->data, vec->size * vec->sizeof_type,
+			(new_alloc - vec->size) * vec->sizeof_type);
+	if (!tmp)
+		return (false);
+	vec->data = tmp;
+	vec->alloc_size = new_alloc;
+	return (true);
+}
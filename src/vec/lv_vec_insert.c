@@ -40,9 +40,7 @@
  * - If `v`, `data` is NULL, `len` is 0, or `index` is out of bounds
  * (`index > v->size`), the function does nothing.
  * - If the vector's current capacity is insufficient (`v->size + len > v->alloc_size`),
- * it reallocates the underlying buffer, doubling its size or making it just
- * large enough to hold the new elements, whichever is greater. New allocated
- * memory is zeroed out.
+ * it grows the underlying buffer with `_lv_vec_grow`.
  * - It uses `lv_memmove` to shift existing data and `lv_memcpy` to copy
  * the new data into the insertion point.
  * - The `size` of the vector is incremented by `len` after successful insertion.
@@ -50,21 +48,10 @@
 
 void	lv_vec_insert(t_vec *v, size_t index, void *data, size_t len)
 {
-	void	*new;
-	size_t	new_alloc;
-
 	if (!v || !data || len == 0 || index > v->size)
 		return ;
-	if (v->alloc_size < v->size + len)
-	{
-		new_alloc = LV_MAX(v->alloc_size * 2, v->size + len);
-		new = lv_extend_zero(v->data, v->alloc_size * v->sizeof_type,
-				(new_alloc - v->alloc_size) * v->sizeof_type);
-		if (!new)
-			return ;
-		v->data = new;
-		v->alloc_size = new_alloc;
-	}
+	if (!_lv_vec_grow(v, len))
+		return ;
 	lv_memmove((t_u8 *)v->data + (index + len) * v->sizeof_type,
 		(t_u8 *)v->data + index * v->sizeof_type,
 		(v->size - index) * v->sizeof_type);
@@ -0,0 +1,82 @@
+/**
+ * lv_vec_map.c
+ *
+ * Copyright (C) 2025 lvzrr <lvzrr@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General
+ * Public License along with this program. If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#include "vec.h"
+
+/*
+ * Function: _map_w
+ * ----------------
+ * Applies `f` to every element of [p, end), `w` bytes apart. Inlined
+ * with a constant `w` for the common element sizes, so the walk is a
+ * plain pointer increment.
+ */
+
+LV_INLINE static inline void	_map_w(t_u8 *p, t_u8 *end, size_t w,
+	void (*f)(void *, void *), void *ctx)
+{
+	while (p < end)
+	{
+		f(p, ctx);
+		p += w;
+	}
+}
+
+/*
+ * Function: lv_vec_map
+ * --------------------
+ * Applies `f` to every element of the vector `v`, in place and in order.
+ *
+ * Parameters:
+ * v   - A pointer to the `t_vec` structure to walk.
+ * f   - The function to apply. It receives a pointer to the element,
+ * which it may modify, and `ctx`.
+ * ctx - An arbitrary pointer passed through to `f`.
+ *
+ * Returns:
+ * None.
+ *
+ * Notes:
+ * - If `v` or `f` is NULL, the function does nothing.
+ * - The data is walked directly, without `lv_vec_get` bounds checks;
+ * `f` must not resize `v`.
+ * - For loops the compiler can vectorize, use the `name_map` accessor
+ * of a typed vector (`LV_VEC_DECL`), which inlines its callback.
+ */
+
+void	lv_vec_map(t_vec *v, void (*f)(void *elem, void *ctx), void *ctx)
+{
+	t_u8	*p;
+	t_u8	*end;
+
+	if (!v || !f || !v->size)
+		return ;
+	p = v->data;
+	end = p + v->size * v->sizeof_type;
+	if (v->sizeof_type == 1)
+		_map_w(p, end, 1, f, ctx);
+	else if (v->sizeof_type == 2)
+		_map_w(p, end, 2, f, ctx);
+	else if (v->sizeof_type == 4)
+		_map_w(p, end, 4, f, ctx);
+	else if (v->sizeof_type == 8)
+		_map_w(p, end, 8, f, ctx);
+	else
+		_map_w(p, end, v->sizeof_type, f, ctx);
+}
@@ -0,0 +1,91 @@
+/**
+ * lv_vec_par_for.c
+ *
+ * Copyright (C) 2025 lvzrr <lvzrr@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General
+ * Public License along with this program. If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#include "pool.h"
+
+typedef struct s_par_for
+{
+	t_vec	*v;
+	size_t	chunk;
+	void	(*f)(void *, size_t, size_t, void *);
+	void	*ctx;
+}	t_par_for;
+
+/*
+ * Function: _par_for_task
+ * -----------------------
+ * Pool task: hands chunk `task` of the vector to the user callback.
+ */
+
+static void	_par_for_task(size_t task, void *arg)
+{
+	t_par_for	*a;
+	size_t		first;
+
+	a = arg;
+	first = task * a->chunk;
+	a->f((t_u8 *)a->v->data + first * a->v->sizeof_type,
+		LV_MIN(a->chunk, a->v->size - first), first, a->ctx);
+}
+
+/*
+ * Function: lv_vec_par_for
+ * ------------------------
+ * Calls `f` on every element of the vector `v`, in parallel, one
+ * contiguous chunk at a time.
+ *
+ * Parameters:
+ * pool - The pool to run on, or NULL for `lv_pool_default()`.
+ * v    - A pointer to the `t_vec` structure to walk.
+ * f    - The callback, called as `f(chunk, n, first, ctx)` where `chunk`
+ * points to the `n` elements starting at index `first`.
+ * ctx  - An arbitrary pointer passed through to `f`.
+ *
+ * Returns:
+ * None.
+ *
+ * Notes:
+ * - If `v` or `f` is NULL, the function does nothing.
+ * - Chunks hold about LV_PAR_CHUNK bytes and never overlap; `f` runs
+ * concurrently on different chunks, so it may write its own chunk but
+ * must synchronize any other shared state.
+ * - Vectors of fewer than LV_PAR_MIN elements are handed to `f` in one
+ * call on the calling thread.
+ * - The vector must not be resized while this runs.
+ */
+
+void	lv_vec_par_for(t_pool *pool, t_vec *v,
+	void (*f)(void *chunk, size_t n, size_t first, void *ctx), void *ctx)
+{
+	t_par_for	a;
+
+	if (!v || !f || !v->size)
+		return ;
+	if (v->size < LV_PAR_MIN)
+	{
+		f(v->data, v->size, 0, ctx);
+		return ;
+	}
+	a.v = v;
+	a.chunk = LV_MAX(LV_PAR_CHUNK / LV_MAX(v->sizeof_type, 1), (size_t)1);
+	a.f = f;
+	a.ctx = ctx;
+	lv_pool_run(pool, (v->size + a.chunk - 1) / a.chunk, _par_for_task, &a);
+}
@@ -0,0 +1,117 @@
+/**
+ * lv_vec_par_reduce.c
+ *
+ * Copyright (C) 2025 lvzrr <lvzrr@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General
+ * Public License along with this program. If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#include "pool.h"
+
+typedef struct s_par_reduce
+{
+	const t_vec	*v;
+	size_t		chunk;
+	t_u8		*parts;
+	size_t		acc_size;
+	void		(*f)(void *, const void *, void *);
+	void		*ctx;
+}	t_par_reduce;
+
+/*
+ * Function: _par_reduce_task
+ * --------------------------
+ * Pool task: folds chunk `task` into its own partial accumulator, which
+ * already holds a copy of the initial value.
+ */
+
+static void	_par_reduce_task(size_t task, void *arg)
+{
+	t_par_reduce	*a;
+	t_vec			view;
+	size_t			first;
+
+	a = arg;
+	first = task * a->chunk;
+	view = *a->v;
+	view.data = (t_u8 *)a->v->data + first * a->v->sizeof_type;
+	view.size = LV_MIN(a->chunk, a->v->size - first);
+	lv_vec_reduce(&view, a->parts + task * a->acc_size, a->f, a->ctx);
+}
+
+/*
+ * Function: lv_vec_par_reduce
+ * ---------------------------
+ * Folds every element of the vector `v` into an accumulator, in
+ * parallel.
+ *
+ * Parameters:
+ * pool     - The pool to run on, or NULL for `lv_pool_default()`.
+ * v        - A pointer to the `t_vec` structure to fold.
+ * acc      - A pointer to the accumulator. On entry it must hold the
+ * identity of the fold (0 for a sum, 1 for a product...), as it seeds
+ * every chunk; it holds the result on return.
+ * acc_size - The size of the accumulator in bytes.
+ * f        - The folding function, called as `f(acc, elem, ctx)`.
+ * merge    - Combines two partial results, called as
+ * `merge(acc, part, ctx)` to fold `part` into `acc`.
+ * ctx      - An arbitrary pointer passed through to `f` and `merge`.
+ *
+ * Returns:
+ * true on success, false if an argument is NULL or the partial results
+ * could not be allocated (`acc` is then left untouched).
+ *
+ * Notes:
+ * - Each chunk of about LV_PAR_CHUNK bytes is folded into its own
+ * partial, and the partials are merged into `acc` in chunk order on the
+ * calling thread. The chunking does not depend on the number of
+ * threads, so with an associative `f` and `merge` the result is the
+ * same on every run and every pool, floating point sums included.
+ * - Vectors of fewer than LV_PAR_MIN elements are folded serially,
+ * straight into `acc`.
+ */
+
+bool	lv_vec_par_reduce(t_pool *pool, const t_vec *v, void *acc,
+	size_t acc_size, void (*f)(void *acc, const void *elem, void *ctx),
+	void (*merge)(void *acc, const void *part, void *ctx), void *ctx)
+{
+	t_par_reduce	a;
+	size_t			tasks;
+	size_t			i;
+
+	if (!v || !acc || !acc_size || !f || !merge)
+		return (false);
+	if (v->size < LV_PAR_MIN)
+		return (lv_vec_reduce(v, acc, f, ctx), true);
+	a.chunk = LV_MAX(LV_PAR_CHUNK / LV_MAX(v->sizeof_type, 1), (size_t)1);
+	tasks = (v->size + a.chunk - 1) / a.chunk;
+	a.parts = lv_alloc(tasks * acc_size);
+	if (!a.parts)
+		return (false);
+	i = 0;
+	while (i < tasks)
+		lv_memcpy(a.parts + i++ * acc_size, acc, acc_size);
+	a.v = v;
+	a.acc_size = acc_size;
+	a.f = f;
+	a.ctx = ctx;
+	lv_pool_run(pool, tasks, _par_reduce_task, &a);
+	lv_memcpy(acc, a.parts, acc_size);
+	i = 1;
+	while (i < tasks)
+		merge(acc, a.parts + i++ * acc_size, ctx);
+	lv_free((void **)&a.parts);
+	return (true);
+}
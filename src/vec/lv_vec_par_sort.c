@@ -0,0 +1,262 @@
+/**
+ * lv_vec_par_sort.c
+ *
+ * Copyright (C) 2025 lvzrr <lvzrr@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General
+ * Public License along with this program. If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#include "pool.h"
+
+/*
+ * One merge task: output elements [k0, k1) of the merge of the sorted
+ * runs [a0, a1) and [a1, a2).
+ */
+
+typedef struct s_par_merge
+{
+	size_t	a0;
+	size_t	a1;
+	size_t	a2;
+	size_t	k0;
+	size_t	k1;
+}	t_par_merge;
+
+typedef struct s_par_sort
+{
+	t_vec		*v;
+	size_t		runs;
+	t_u8		*src;
+	t_u8		*dst;
+	t_par_merge	*merges;
+	int			(*cmp)(const void *, const void *);
+}	t_par_sort;
+
+/*
+ * Function: _sort_task
+ * --------------------
+ * Pool task: sorts run `task` of the vector in place.
+ */
+
+static void	_sort_task(size_t task, void *arg)
+{
+	t_par_sort	*a;
+	t_vec		view;
+	size_t		lo;
+
+	a = arg;
+	lo = a->v->size * task / a->runs;
+	view = *a->v;
+	view.data = (t_u8 *)a->v->data + lo * a->v->sizeof_type;
+	view.size = a->v->size * (task + 1) / a->runs - lo;
+	lv_vec_sort(&view, a->cmp);
+}
+
+/*
+ * Function: _corank
+ * -----------------
+ * Merge path split: returns how many of the first `k` elements of the
+ * stable merge of `a` (`na` elements) and `b` (`nb` elements) come from
+ * `a`, in O(log k) comparisons.
+ */
+
+static size_t	_corank(const t_u8 *a, size_t na, const t_u8 *b, size_t nb,
+	size_t k, size_t w, int (*cmp)(const void *, const void *))
+{
+	size_t	lo;
+	size_t	hi;
+	size_t	i;
+
+	lo = 0;
+	if (k > nb)
+		lo = k - nb;
+	hi = LV_MIN(k, na);
+	while (lo < hi)
+	{
+		i = lo + (hi - lo) / 2;
+		if (cmp(a + i * w, b + (k - i - 1) * w) <= 0)
+			lo = i + 1;
+		else
+			hi = i;
+	}
+	return (lo);
+}
+
+/*
+ * Function: _merge_w
+ * ------------------
+ * Writes `n` elements of the stable merge of `a` and `b`, starting at
+ * their `i`th and `j`th elements, to `out`. Ties go to `a`. Inlined with
+ * a constant `w` for the common element sizes.
+ */
+
+LV_INLINE static inline void	_merge_w(t_u8 *out, size_t n,
+	const t_u8 *a, size_t i, size_t na, const t_u8 *b, size_t j, size_t nb,
+	size_t w, int (*cmp)(const void *, const void *))
+{
+	const t_u8	*src;
+
+	while (n--)
+	{
+		if (j >= nb || (i < na && cmp(a + i * w, b + j * w) <= 0))
+			src = a + i++ * w;
+		else
+			src = b + j++ * w;
+		if (__builtin_constant_p(w))
+			__builtin_memcpy(out, src, w);
+		else
+			lv_memcpy(out, src, w);
+		out += w;
+	}
+}
+
+/*
+ * Function: _merge_task
+ * ---------------------
+ * Pool task: locates the start of its output block on both runs, then
+ * merges up to the end of the block.
+ */
+
+static void	_merge_task(size_t task, void *arg)
+{
+	t_par_sort	*a;
+	t_par_merge	*m;
+	size_t		w;
+	size_t		i;
+	t_u8		*out;
+
+	a = arg;
+	m = &a->merges[task];
+	w = a->v->sizeof_type;
+	i = _corank(a->src + m->a0 * w, m->a1 - m->a0, a->src + m->a1 * w,
+			m->a2 - m->a1, m->k0, w, a->cmp);
+	out = a->dst + (m->a0 + m->k0) * w;
+	if (w == 4)
+		_merge_w(out, m->k1 - m->k0, a->src + m->a0 * w, i, m->a1 - m->a0,
+			a->src + m->a1 * w, m->k0 - i, m->a2 - m->a1, 4, a->cmp);
+	else if (w == 8)
+		_merge_w(out, m->k1 - m->k0, a->src + m->a0 * w, i, m->a1 - m->a0,
+			a->src + m->a1 * w, m->k0 - i, m->a2 - m->a1, 8, a->cmp);
+	else
+		_merge_w(out, m->k1 - m->k0, a->src + m->a0 * w, i, m->a1 - m->a0,
+			a->src + m->a1 * w, m->k0 - i, m->a2 - m->a1, w, a->cmp);
+}
+
+/*
+ * Function: _merge_round
+ * ----------------------
+ * Merges runs `2r` and `2r + 1` (`width` runs of the initial split
+ * each) from `a->src` into `a->dst`, for every `r`, cutting each merge
+ * into output blocks of `block` elements. A trailing unpaired run is
+ * copied over as a merge with an empty run. Returns the number of tasks.
+ */
+
+static size_t	_merge_round(t_par_sort *a, size_t width, size_t block)
+{
+	size_t	r;
+	size_t	k;
+	size_t	t;
+	size_t	n;
+
+	n = a->v->size;
+	t = 0;
+	r = 0;
+	while (r < a->runs)
+	{
+		k = 0;
+		while (k < n * LV_MIN(r + 2 * width, a->runs) / a->runs
+			- n * r / a->runs)
+		{
+			a->merges[t].a0 = n * r / a->runs;
+			a->merges[t].a1 = n * LV_MIN(r + width, a->runs) / a->runs;
+			a->merges[t].a2 = n * LV_MIN(r + 2 * width, a->runs) / a->runs;
+			a->merges[t].k0 = k;
+			k = LV_MIN(k + block, a->merges[t].a2 - a->merges[t].a0);
+			a->merges[t++].k1 = k;
+		}
+		r += 2 * width;
+	}
+	return (t);
+}
+
+/*
+ * Function: lv_vec_par_sort
+ * -------------------------
+ * Sorts the elements of the vector `v` in place, in parallel.
+ *
+ * Parameters:
+ * pool - The pool to run on, or NULL for `lv_pool_default()`.
+ * v    - A pointer to the `t_vec` structure to sort.
+ * cmp  - The comparison function, with the `qsort` contract.
+ *
+ * Returns:
+ * true on success, false if `v` or `cmp` is NULL.
+ *
+ * Notes:
+ * - The vector is split into one run per pool thread, each sorted with
+ * `lv_vec_sort`, then the runs are merged pairwise through a scratch
+ * buffer of the vector's size. Every merge is cut into blocks of about
+ * LV_PAR_CHUNK bytes, whose start is found on both runs by binary
+ * search (merge path), so all threads take part in every round.
+ * - Vectors of fewer than LV_PAR_MIN elements, deterministic pools and
+ * single thread pools use `lv_vec_sort` directly, as does a failed
+ * scratch allocation.
+ * - Like `lv_vec_sort`, the sort is not stable: the order of equal
+ * elements may depend on the number of threads.
+ */
+
+bool	lv_vec_par_sort(t_pool *pool, t_vec *v,
+	int (*cmp)(const void *, const void *))
+{
+	t_par_sort	a;
+	size_t		width;
+	size_t		block;
+	t_u8		*scratch;
+
+	if (!v || !cmp)
+		return (false);
+	if (!pool)
+		pool = lv_pool_default();
+	a.runs = lv_pool_size(pool);
+	if (v->size < LV_PAR_MIN || a.runs < 2 || !v->sizeof_type)
+		return (lv_vec_sort(v, cmp), true);
+	block = LV_MAX(LV_PAR_CHUNK / v->sizeof_type, (size_t)1);
+	scratch = lv_alloc(v->size * v->sizeof_type);
+	a.merges = lv_alloc((v->size / block + a.runs + 1) * sizeof(t_par_merge));
+	if (!scratch || !a.merges)
+	{
+		lv_free((void **)&scratch);
+		lv_free((void **)&a.merges);
+		return (lv_vec_sort(v, cmp), true);
+	}
+	a.v = v;
+	a.cmp = cmp;
+	lv_pool_run(pool, a.runs, _sort_task, &a);
+	a.src = v->data;
+	a.dst = scratch;
+	width = 1;
+	while (width < a.runs)
+	{
+		lv_pool_run(pool, _merge_round(&a, width, block), _merge_task, &a);
+		a.dst = a.src;
+		a.src = (a.src == scratch) ? v->data : scratch;
+		width *= 2;
+	}
+	if (a.src == scratch)
+		lv_memcpy(v->data, scratch, v->size * v->sizeof_type);
+	lv_free((void **)&scratch);
+	lv_free((void **)&a.merges);
+	return (true);
+}
@@ -38,33 +38,27 @@
  * Notes:
  * - If `vec` or `data` is NULL, the function does nothing.
  * - If `vec->size + len` exceeds `vec->alloc_size`, the vector's capacity
- * is expanded by doubling its current `alloc_size` or making it just large
- * enough to hold the new elements, whichever is greater. New allocated
- * memory is zeroed out.
- * - It uses `lv_extend_zero` for reallocation and `lv_memcpy` to copy
- * the new data.
+ * is expanded by LV_VEC_GROWTH percent or made just large enough to hold
+ * the new elements, whichever is greater (see `_lv_vec_grow`). Pushes of up to
+ * `LV_SMALL_COPY` bytes (the usual one-struct case) are copied with
+ * `_lv_memcpy_small`, larger ones with `lv_memcpy`.
  * - The `size` of the vector is incremented by `len` after successful push.
  */
 
 void	lv_vec_push(t_vec *vec, void *data, size_t len)
 {
-	void	*tmp;
-	size_t	new_alloc;
+	size_t	bytes;
 
 	if (!vec || !data)
 		return ;
-	if (vec->size + len > vec->alloc_size)
-	{
-		new_alloc = LV_MAX(vec->alloc_size * 2, vec->size + len);
-		tmp = lv_extend_zero(vec->data,
-				vec->alloc_size * vec->sizeof_type,
-				(new_alloc - vec->alloc_size) * vec->sizeof_type);
-		if (!tmp)
-			return ;
-		vec->data = tmp;
-		vec->alloc_size = new_alloc;
-	}
-	lv_memcpy(((t_u8 *)(vec->data) + (vec->size * vec->sizeof_type)),
-		data, len * vec->sizeof_type);
+	if (!_lv_vec_grow(vec, len))
+		return ;
+	bytes = len * vec->sizeof_type;
+	if (bytes <= LV_SMALL_COPY)
+		_lv_memcpy_small((t_u8 *)vec->data + vec->size * vec->sizeof_type,
+			data, bytes);
+	else
+		lv_memcpy((t_u8 *)vec->data + vec->size * vec->sizeof_type,
+			data, bytes);
 	vec->size += len;
 }
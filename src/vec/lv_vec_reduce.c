@@ -0,0 +1,84 @@
+/**
+ * lv_vec_reduce.c
+ *
+ * Copyright (C) 2025 lvzrr <lvzrr@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General
+ * Public License along with this program. If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#include "vec.h"
+
+/*
+ * Function: _reduce_w
+ * -------------------
+ * Folds [p, end), `w` bytes apart, into `acc`. Inlined with a constant
+ * `w` for the common element sizes.
+ */
+
+LV_INLINE static inline void	_reduce_w(const t_u8 *p, const t_u8 *end,
+	size_t w, void *acc, void (*f)(void *, const void *, void *),
+	void *ctx)
+{
+	while (p < end)
+	{
+		f(acc, p, ctx);
+		p += w;
+	}
+}
+
+/*
+ * Function: lv_vec_reduce
+ * -----------------------
+ * Folds every element of the vector `v`, in order, into an accumulator.
+ *
+ * Parameters:
+ * v   - A pointer to the `t_vec` structure to fold.
+ * acc - A pointer to the accumulator, holding its initial value. It
+ * holds the result on return.
+ * f   - The folding function, called as `f(acc, elem, ctx)` for each
+ * element.
+ * ctx - An arbitrary pointer passed through to `f`.
+ *
+ * Returns:
+ * None.
+ *
+ * Notes:
+ * - If `v`, `acc` or `f` is NULL, the function does nothing.
+ * - For loops the compiler can vectorize, use the `name_reduce`
+ * accessor of a typed vector (`LV_VEC_DECL`), which inlines its
+ * callback.
+ */
+
+void	lv_vec_reduce(const t_vec *v, void *acc,
+	void (*f)(void *acc, const void *elem, void *ctx), void *ctx)
+{
+	const t_u8	*p;
+	const t_u8	*end;
+
+	if (!v || !acc || !f || !v->size)
+		return ;
+	p = v->data;
+	end = p + v->size * v->sizeof_type;
+	if (v->sizeof_type == 1)
+		_reduce_w(p, end, 1, acc, f, ctx);
+	else if (v->sizeof_type == 2)
+		_reduce_w(p, end, 2, acc, f, ctx);
+	else if (v->sizeof_type == 4)
+		_reduce_w(p, end, 4, acc, f, ctx);
+	else if (v->sizeof_type == 8)
+		_reduce_w(p, end, 8, acc, f, ctx);
+	else
+		_reduce_w(p, end, v->sizeof_type, acc, f, ctx);
+}
@@ -35,24 +35,17 @@
  * None.
  *
  * Notes:
- * - If `v` is NULL, `n` is 0, or `n` is less than or equal to the current
+ * - If `v` is NULL, `n` is 0, or `v->size + n` already fits in
  * `v->alloc_size`, the function does nothing.
- * - It uses `lv_extend_zero` to reallocate the underlying buffer and
- * zero out any newly added space.
- * - The `alloc_size` of the vector is increased by `n` after successful reservation.
- * The `size` (number of actual elements) remains unchanged.
+ * - It grows the buffer with `_lv_vec_grow`, so reserving in small steps
+ * still grows the capacity geometrically.
+ * - `alloc_size` always matches the size of the buffer. The `size`
+ * (number of actual elements) remains unchanged.
  */
 
 void	lv_vec_reserve(t_vec *v, size_t n)
 {
-	void	*new;
-
-	if (!v || !n || n <= v->alloc_size)
-		return ;
-	new = lv_extend_zero(v->data, v->alloc_size * v->sizeof_type,
-			n * v->sizeof_type);
-	if (!new)
+	if (!v || !n)
 		return ;
-	v->data = new;
-	v->alloc_size += n;
+	_lv_vec_grow(v, n);
 }
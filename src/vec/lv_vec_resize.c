@@ -0,0 +1,86 @@
+/**
+ * lv_vec_resize.c
+ *
+ * Copyright (C) 2025 lvzrr <lvzrr@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General
+ * Public License along with this program. If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#include "vec.h"
+
+/*
+ * Function: lv_vec_resize
+ * -----------------------
+ * Sets the number of elements of `v` to `n`, dropping elements from the
+ * end or appending copies of `fill`.
+ *
+ * Parameters:
+ * v    - A pointer to the `t_vec` structure to resize.
+ * n    - The new number of elements.
+ * fill - A pointer to one element to append as many times as needed, or
+ * NULL to append zeroed elements. It may point into `v` itself.
+ *
+ * Returns:
+ * None.
+ *
+ * Notes:
+ * - Dropped elements are zeroed, as `lv_vec_pop` does; the capacity is
+ * kept (see `lv_vec_fit`).
+ * - The fill runs in O(log n) `lv_memcpy` calls: the filled range is
+ * doubled by copying it onto itself.
+ * - On allocation failure the vector is left unchanged.
+ * - A `fill` element inside the vector is located again after growing,
+ * as growing may move the buffer.
+ */
+
+void	lv_vec_resize(t_vec *v, size_t n, const void *fill)
+{
+	t_u8	*start;
+	size_t	done;
+	size_t	total;
+	size_t	self;
+
+	if (!v || !v->sizeof_type || n == v->size)
+		return ;
+	if (n < v->size)
+	{
+		lv_bzero((t_u8 *)v->data + n * v->sizeof_type,
+			(v->size - n) * v->sizeof_type);
+		v->size = n;
+		return ;
+	}
+	self = (t_uptr)fill - (t_uptr)v->data;
+	if (!fill || self >= v->size * v->sizeof_type)
+		self = SIZE_MAX;
+	if (!_lv_vec_grow(v, n - v->size))
+		return ;
+	if (self != SIZE_MAX)
+		fill = (t_u8 *)v->data + self;
+	start = (t_u8 *)v->data + v->size * v->sizeof_type;
+	total = (n - v->size) * v->sizeof_type;
+	v->size = n;
+	if (!fill)
+	{
+		lv_bzero(start, total);
+		return ;
+	}
+	lv_memcpy(start, fill, v->sizeof_type);
+	done = v->sizeof_type;
+	while (done < total)
+	{
+		lv_memcpy(start + done, start, LV_MIN(done, total - done));
+		done *= 2;
+	}
+}
@@ -21,43 +21,25 @@
 #include "vec.h"
 
 /*
- * Function: lv_vec_reserve
- * ------------------------
- * Ensures that the vector has enough capacity to hold at least `n` more
- * elements without requiring reallocation. If the current allocated size
- * is already sufficient, it does nothing. Otherwise, it extends the capacity.
+ * Function: lv_vec_rev
+ * --------------------
+ * Reverses the order of the elements of the vector `v` in place.
  *
  * Parameters:
- * v - A pointer to the `t_vec` structure for which to reserve space.
- * n - The number of additional elements to reserve space for.
+ * v - A pointer to the `t_vec` structure to reverse.
  *
  * Returns:
  * None.
  *
  * Notes:
- * - If `v` is NULL, `n` is 0, or `n` is less than or equal to the current
- * `v->alloc_size`, the function does nothing.
- * - It uses `lv_extend_zero` to reallocate the underlying buffer and
- * zero out any newly added space.
- * - The `alloc_size` of the vector is increased by `n` after successful reservation.
- * The `size` (number of actual elements) remains unchanged.
+ * - If `v` is NULL or holds fewer than 2 elements, it does nothing.
+ * - It uses `lv_memrev`, which reverses 1, 2, 4 and 8 byte elements a
+ * whole vector register at a time from both ends.
  */
 
 void	lv_vec_rev(t_vec *v)
 {
-	size_t	half;
-	size_t	i;
-
 	if (!v || v->size < 2)
 		return ;
-	half = v->size / 2;
-	i = 0;
-	while (i < half)
-	{
-		lv_memswap(
-			(t_u8 *)v->data + (v->sizeof_type * i),
-			(t_u8 *)v->data + (v->sizeof_type * (v->size - i - 1)),
-			v->sizeof_type);
-		i++;
-	}
+	lv_memrev(v->data, v->size, v->sizeof_type);
 }
@@ -0,0 +1,276 @@
+/**
+ * lv_vec_sort.c
+ *
+ * Copyright (C) 2025 lvzrr <lvzrr@proton.me>
+ *
+ * This program is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version
+ * 3 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be
+ * useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General
+ * Public License along with this program. If not, see
+ * <https://www.gnu.org/licenses/>.
+ */
+
+#include "vec.h"
+
+/*
+ * Function: _swap_w
+ * -----------------
+ * Swaps two `w` byte elements. With a constant `w` of at most 8 (the
+ * specialized sorts) it is two loads and two stores.
+ */
+
+LV_INLINE static inline void	_swap_w(t_u8 *a, t_u8 *b, size_t w)
+{
+	t_u64	x;
+	t_u64	y;
+
+	if (__builtin_constant_p(w) && w <= 8)
+	{
+		__builtin_memcpy(&x, a, w);
+		__builtin_memcpy(&y, b, w);
+		__builtin_memcpy(a, &y, w);
+		__builtin_memcpy(b, &x, w);
+		return ;
+	}
+	while (w >= 8)
+	{
+		__builtin_memcpy(&x, a, 8);
+		__builtin_memcpy(&y, b, 8);
+		__builtin_memcpy(a, &y, 8);
+		__builtin_memcpy(b, &x, 8);
+		a += 8;
+		b += 8;
+		w -= 8;
+	}
+	while (w--)
+	{
+		x = *a;
+		*a++ = *b;
+		*b++ = (t_u8)x;
+	}
+}
+
+/*
+ * Function: _insertion_w
+ * ----------------------
+ * Insertion sort of `n` elements, for the small ranges quicksort leaves.
+ */
+
+LV_INLINE static inline void	_insertion_w(t_u8 *b, size_t n, size_t w,
+	int (*cmp)(const void *, const void *))
+{
+	size_t	i;
+	t_u8	*p;
+
+	i = 1;
+	while (i < n)
+	{
+		p = b + i * w;
+		while (p > b && cmp(p - w, p) > 0)
+		{
+			_swap_w(p - w, p, w);
+			p -= w;
+		}
+		i++;
+	}
+}
+
+/*
+ * Function: _partition_w
+ * ----------------------
+ * Moves the median of the first, middle and last elements to the front,
+ * partitions the rest around it and puts it in its final place.
+ * Returns that index: every element before it compares less or equal,
+ * every one after greater or equal. Elements equal to the pivot stop
+ * both scans, so runs of duplicates split evenly.
+ */
+
+LV_INLINE static inline size_t	_partition_w(t_u8 *b, size_t n, size_t w,
+	int (*cmp)(const void *, const void *))
+{
+	t_u8	*m;
+	t_u8	*l;
+	size_t	i;
+	size_t	j;
+
+	m = b + (n / 2) * w;
+	l = b + (n - 1) * w;
+	if (cmp(m, b) < 0)
+		_swap_w(m, b, w);
+	if (cmp(l, m) < 0)
+	{
+		_swap_w(l, m, w);
+		if (cmp(m, b) < 0)
+			_swap_w(m, b, w);
+	}
+	_swap_w(b, m, w);
+	i = 1;
+	j = n - 1;
+	while (1)
+	{
+		while (i <= j && cmp(b + i * w, b) < 0)
+			i++;
+		while (i <= j && cmp(b + j * w, b) > 0)
+			j--;
+		if (i >= j)
+			break ;
+		_swap_w(b + i++ * w, b + j-- * w, w);
+	}
+	_swap_w(b, b + j * w, w);
+	return (j);
+}
+
+/*
+ * Function: _sift_w
+ * -----------------
+ * Sifts element `i` down the max-heap of the first `n` elements.
+ */
+
+LV_INLINE static inline void	_sift_w(t_u8 *b, size_t i, size_t n, size_t w,
+	int (*cmp)(const void *, const void *))
+{
+	size_t	c;
+
+	while (i < n / 2)
+	{
+		c = 2 * i + 1;
+		if (c + 1 < n && cmp(b + c * w, b + (c + 1) * w) < 0)
+			c++;
+		if (cmp(b + i * w, b + c * w) >= 0)
+			return ;
+		_swap_w(b + i * w, b + c * w, w);
+		i = c;
+	}
+}
+
+/*
+ * Function: _heap_w
+ * -----------------
+ * Heapsort, the fallback for ranges quicksort keeps partitioning badly.
+ */
+
+LV_INLINE static inline void	_heap_w(t_u8 *b, size_t n, size_t w,
+	int (*cmp)(const void *, const void *))
+{
+	size_t	i;
+
+	i = n / 2;
+	while (i--)
+		_sift_w(b, i, n, w, cmp);
+	while (n > 1)
+	{
+		n--;
+		_swap_w(b, b + n * w, w);
+		_sift_w(b, 0, n, w, cmp);
+	}
+}
+
+/*
+ * Function: _sort_w
+ * -----------------
+ * Introsort: quicksort down to LV_SORT_CUTOFF elements, then insertion
+ * sort, with a budget of 2 * log2(n) partitioning levels after which a
+ * range is heapsorted, so the worst case stays O(n log n). The larger
+ * side of each partition is pushed on a local stack and the smaller one
+ * sorted first, so 64 slots always suffice. Being iterative, it inlines
+ * into `lv_vec_sort` once per element size.
+ */
+
+LV_INLINE static inline void	_sort_w(t_u8 *b, size_t n, size_t w,
+	int (*cmp)(const void *, const void *))
+{
+	t_u8	*stack_b[64];
+	size_t	stack_n[64];
+	int		stack_d[64];
+	size_t	top;
+	size_t	p;
+	int		depth;
+
+	top = 0;
+	depth = 2 * (64 - __builtin_clzll((unsigned long long)n));
+	while (1)
+	{
+		while (n > LV_SORT_CUTOFF && depth > 0)
+		{
+			p = _partition_w(b, n, w, cmp);
+			depth--;
+			stack_d[top] = depth;
+			if (p < n - p - 1)
+			{
+				stack_b[top] = b + (p + 1) * w;
+				stack_n[top++] = n - p - 1;
+				n = p;
+			}
+			else
+			{
+				stack_b[top] = b;
+				stack_n[top++] = p;
+				b += (p + 1) * w;
+				n -= p + 1;
+			}
+		}
+		if (n > LV_SORT_CUTOFF)
+			_heap_w(b, n, w, cmp);
+		else
+			_insertion_w(b, n, w, cmp);
+		if (!top)
+			return ;
+		top--;
+		b = stack_b[top];
+		n = stack_n[top];
+		depth = stack_d[top];
+	}
+}
+
+/*
+ * Function: lv_vec_sort
+ * ---------------------
+ * Sorts the elements of the vector `v` in place.
+ *
+ * Parameters:
+ * v   - A pointer to the `t_vec` structure to sort.
+ * cmp - The comparison function, with the `qsort` contract: negative,
+ * zero or positive as its first argument orders before, with, or after
+ * its second.
+ *
+ * Returns:
+ * None.
+ *
+ * Notes:
+ * - If `v` or `cmp` is NULL, the function does nothing.
+ * - Introsort: median-of-three quicksort with an insertion sort cutoff
+ * (LV_SORT_CUTOFF), falling back to heapsort on ranges that partition
+ * badly, so it is O(n log n) in the worst case. The sort is not stable.
+ * - For plain unsigned integer keys, the radix sorts
+ * (`lv_vec_radix_sort_u32` and friends) are several times faster.
+ * - It is compiled separately for 1, 2, 4 and 8 byte elements, where
+ * moving an element is a single load and store; other sizes are
+ * swapped in 8-byte words.
+ */
+
+void	lv_vec_sort(t_vec *v, int (*cmp)(const void *, const void *))
+{
+	size_t	w;
+
+	if (!v || !cmp || v->size < 2)
+		return ;
+	w = v->sizeof_type;
+	if (w == 1)
+		_sort_w(v->data, v->size, 1, cmp);
+	else if (w == 2)
+		_sort_w(v->data, v->size, 2, cmp);
+	else if (w == 4)
+		_sort_w(v->data, v->size, 4, cmp);
+	else if (w == 8)
+		_sort_w(v->data, v->size, 8, cmp);
+	else if (w)
+		_sort_w(v->data, v->size, w, cmp);
+}
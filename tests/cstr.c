@@ -7,6 +7,7 @@
 #include <stdio.h>
 #include <unistd.h>
 #include <ctype.h>
+#include <sys/mman.h>
 
 #define L1_TEST 10
 #define L2_TEST 500
@@ -75,6 +76,45 @@ void strlen_tests() {
         assert(lv_strlen("hello\0world") == 5);
 		printf("lv_strlen passed tests: %lu\r", i++);
     }
+    {
+        const t_u32 levels[] = {LV_CPU_SSE2, LV_CPU_AVX2, LV_CPU_AVX512};
+        LV_DEFER char *buf = lv_alloc(L2_TEST);
+
+        memset(buf, 'x', L2_TEST);
+        for (size_t l = 0; l < sizeof(levels) / sizeof(*levels); l++) {
+            lv_cpu_dispatch(levels[l]);
+            for (size_t off = 0; off < 70; off++) {
+                for (size_t len = 0; len < 420; len += (len < 140) ? 1 : 13) {
+                    buf[off + len] = '\0';
+                    assert(lv_strlen(buf + off) == len);
+                    buf[off + len] = 'x';
+                }
+            }
+        }
+        lv_cpu_dispatch(LV_CPU_SSE2 | LV_CPU_AVX2 | LV_CPU_AVX512);
+        printf("lv_strlen passed tests: %lu\r", i++);
+    }
+    {
+        const t_u32 levels[] = {LV_CPU_SSE2, LV_CPU_AVX2, LV_CPU_AVX512};
+        long pg = sysconf(_SC_PAGESIZE);
+        char *map = mmap(NULL, (size_t)pg * 3, PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+        assert(map != MAP_FAILED);
+        assert(mprotect(map, (size_t)pg, PROT_NONE) == 0);
+        assert(mprotect(map + pg * 2, (size_t)pg, PROT_NONE) == 0);
+        memset(map + pg, 'x', (size_t)pg);
+        map[pg * 2 - 1] = '\0';
+        for (size_t l = 0; l < sizeof(levels) / sizeof(*levels); l++) {
+            lv_cpu_dispatch(levels[l]);
+            for (size_t len = 0; len < 300; len++)
+                assert(lv_strlen(map + pg * 2 - 1 - len) == len);
+            assert(lv_strlen(map + pg) == (size_t)pg - 1);
+        }
+        lv_cpu_dispatch(LV_CPU_SSE2 | LV_CPU_AVX2 | LV_CPU_AVX512);
+        munmap(map, (size_t)pg * 3);
+        printf("lv_strlen passed tests: %lu\r", i++);
+    }
     {
         assert(lv_strlen(NULL) == 0);
         printf("lv_strlen passed tests: %lu\r\n", i++);
@@ -313,6 +353,19 @@ void strnstr_tests() {
         assert(lv_strnstr("", "a", 0) == NULL);
         printf("lv_strnstr passed tests: %lu\r", i++);
     }
+    {
+        const char *log = "2025-01-01 INFO request served in 12ms; "
+            "2025-01-01 ERROR connection reset by peer while reading body";
+        const char *nd = "ERROR connection reset by peer while reading";
+        char *hit = strstr(log, nd);
+
+        assert(lv_strnstr(log, nd, strlen(log)) == hit);
+        assert(lv_strnstr(log, nd, (size_t)(hit - log) + strlen(nd)) == hit);
+        assert(lv_strnstr(log, nd, (size_t)(hit - log) + strlen(nd) - 1) == NULL);
+        assert(lv_strnstr(log, "body", SIZE_MAX) == log + strlen(log) - 4);
+        assert(lv_strnstr("ab\0cd", "cd", 5) == NULL);
+        printf("lv_strnstr passed tests: %lu\r", i++);
+    }
     {
         assert(lv_strnstr(NULL, "a", 1) == NULL);
         assert(lv_strnstr("a", NULL, 1) == "a");
@@ -474,10 +527,49 @@ void split_tests() {
     {
         LV_DEFER_ARR void **arr = (void **) lv_split(NULL, ' ');
         assert(arr == NULL);
+        printf("lv_split passed tests: %lu\r", i++);
+    }
+    {
+        LV_DEFER_ARR void **arr = (void **) lv_split_any(" a\tbb \n\nccc, d;", " \t\n,;");
+        assert(arr != NULL);
+        assert(strcmp(arr[0], "a") == 0);
+        assert(strcmp(arr[1], "bb") == 0);
+        assert(strcmp(arr[2], "ccc") == 0);
+        assert(strcmp(arr[3], "d") == 0);
+        assert(arr[4] == NULL);
+        printf("lv_split passed tests: %lu\r", i++);
+    }
+    {
+        LV_DEFER_ARR void **arr = (void **) lv_split_any(" \t \n", " \t\n");
+        assert(arr != NULL);
+        assert(arr[0] == NULL);
+        assert(lv_split_any("abc", NULL) == NULL);
         printf("lv_split passed tests: %lu\r\n", i++);
     }
 }
 
+void strpbrk_tests() {
+    size_t i = 0;
+    const char *str = "the quick brown fox, jumped; over the lazy dog";
+    {
+        assert(lv_strpbrk(str, ",;") == strpbrk(str, ",;"));
+        assert(lv_strpbrk(str, "zyx") == strpbrk(str, "zyx"));
+        assert(lv_strpbrk(str, "Q!") == NULL);
+        assert(lv_strpbrk(str, "") == NULL);
+        printf("lv_strpbrk passed tests: %lu\r", i++);
+    }
+    {
+        char buf[300];
+        for (int k = 0; k < 299; k++)
+            buf[k] = (char)(1 + k % 200);
+        buf[299] = '\0';
+        assert(lv_strpbrk(buf, "\xc8\xc7") == strpbrk(buf, "\xc8\xc7"));
+        assert(lv_strpbrk(buf, "\xff\xfe") == NULL);
+        assert(lv_strpbrk(NULL, "a") == NULL);
+        printf("lv_strpbrk passed tests: %lu\r\n", i++);
+    }
+}
+
 void strcmp_tests() {
     size_t i = 0;
     {
@@ -557,6 +649,7 @@ int main() {
     strjoin_tests();
     substr_tests();
     split_tests();
+    strpbrk_tests();
     strcmp_tests();
     isnumeric_tests();
     printf("[TESTER] All cstr tests passed\n");
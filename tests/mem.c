@@ -5,6 +5,8 @@
 #include <assert.h>
 #include <stdio.h>
 #include <unistd.h>
+#include <sys/mman.h>
+#include <pthread.h>
 
 #define	L1_TEST 10
 #define	L2_TEST 500
@@ -523,6 +525,963 @@ void	arena_allocation_tests()
 	}
 }
 
+static void	*arena_worker(void *arg)
+{
+	t_u8	id = (t_u8)(uintptr_t)arg;
+	t_arena	*a = lv_arena_create(256);
+	char	*blocks[64];
+
+	assert(a != NULL);
+	for (int round = 0; round < 50; round++)
+	{
+		for (int j = 0; j < 64; j++)
+		{
+			size_t	n = 16 + (size_t)((j * 37 + round) % 900);
+
+			blocks[j] = lv_arena_alloc(a, n);
+			assert(blocks[j] != NULL);
+			assert(((uintptr_t)blocks[j] % DEF_ALIGN) == 0);
+			memset(blocks[j], id + j, n);
+		}
+		for (int j = 0; j < 64; j++)
+			assert(blocks[j][15] == (char)(id + j));
+		lv_arena_reset(a);
+	}
+	lv_arena_destroy(a);
+	for (int j = 0; j < 200; j++)
+	{
+		char	*p = lv_arena(100);
+
+		assert(p != NULL);
+		memset(p, id, 100);
+	}
+	return (NULL);
+}
+
+void	arena_thread_tests()
+{
+	size_t		i = 0;
+	pthread_t	th[4];
+	t_arena		*a;
+
+	{
+		a = lv_arena_create(0);
+		char *x = lv_arena_alloc(a, 10);
+		char *y = lv_arena_alloc(a, 10);
+		assert(x && y && y - x == DEF_ALIGN);
+		assert(lv_arena_alloc(a, 0) == NULL);
+		assert(lv_arena_alloc(NULL, 10) == NULL);
+		char *big = lv_arena_alloc(a, DEFAULT_ARENA_SIZE * 3);
+		assert(big != NULL);
+		memset(big, 1, DEFAULT_ARENA_SIZE * 3);
+		lv_arena_reset(a);
+		assert(lv_arena_alloc(a, 10) == x);
+		lv_arena_destroy(a);
+		lv_arena_destroy(NULL);
+		lv_arena_reset(NULL);
+		printf("lv_arena handle passed tests: %lu\r", i++);
+	}
+	{
+		for (uintptr_t t = 0; t < 4; t++)
+			assert(!pthread_create(&th[t], NULL, arena_worker, (void *)t));
+		for (int t = 0; t < 4; t++)
+			assert(!pthread_join(th[t], NULL));
+		printf("lv_arena threads passed tests: %lu\r\n", i++);
+	}
+}
+
+static char	*arena_scoped(t_arena *a, char **inner)
+{
+	LV_ARENA_SCOPE t_arena_mark m = lv_arena_mark(a);
+
+	*inner = lv_arena_alloc(a, 64);
+	return (lv_arena_alloc(a, DEFAULT_ARENA_SIZE));
+}
+
+void	arena_mark_tests()
+{
+	size_t	i = 0;
+	t_arena	*a = lv_arena_create(0);
+
+	{
+		char			*base = lv_arena_alloc(a, 32);
+		t_arena_mark	m = lv_arena_mark(a);
+		char			*x = lv_arena_alloc(a, 100);
+		char			*big[4];
+
+		for (int j = 0; j < 4; j++)
+			big[j] = lv_arena_alloc(a, DEFAULT_ARENA_SIZE);
+		lv_arena_rewind(m);
+		assert(lv_arena_alloc(a, 100) == x);
+		for (int j = 0; j < 4; j++)
+			assert(lv_arena_alloc(a, DEFAULT_ARENA_SIZE) == big[j]);
+		lv_arena_reset(a);
+		assert(lv_arena_alloc(a, 32) == base);
+		printf("lv_arena_rewind passed tests: %lu\r", i++);
+	}
+	{
+		t_arena_mark	outer = lv_arena_mark(a);
+		char			*p = lv_arena_alloc(a, 16);
+		t_arena_mark	inner = lv_arena_mark(a);
+
+		lv_arena_alloc(a, 5000);
+		lv_arena_rewind(inner);
+		assert(lv_arena_alloc(a, 16) == p + DEF_ALIGN);
+		lv_arena_rewind(outer);
+		assert(lv_arena_alloc(a, 16) == p);
+		printf("lv_arena_rewind passed tests: %lu\r", i++);
+	}
+	{
+		char	*in1;
+		char	*in2;
+		char	*b1 = arena_scoped(a, &in1);
+		char	*b2 = arena_scoped(a, &in2);
+
+		assert(in1 == in2 && b1 == b2);
+		printf("LV_ARENA_SCOPE passed tests: %lu\r", i++);
+	}
+	{
+		t_arena_mark	m = lv_arena_mark(NULL);
+		char			*p = lv_arena(40);
+
+		assert(m.arena != NULL);
+		lv_arena_rewind(m);
+		assert(lv_arena(40) == p);
+		lv_arena_rewind(m);
+		lv_arena_rewind((t_arena_mark){0});
+		printf("lv_arena_mark passed tests: %lu\r\n", i++);
+	}
+	lv_arena_destroy(a);
+}
+
+void	arena_aligned_tests()
+{
+	size_t	i = 0;
+	t_arena	*a = lv_arena_create(0);
+
+	{
+		char	*p = lv_arena_alloc_aligned(a, 3, 1);
+
+		for (int j = 0; j < 100; j++)
+			assert(lv_arena_alloc_aligned(a, 3, 1) == p + 3 * (j + 1));
+		for (size_t al = 1; al <= 4096; al <<= 1)
+		{
+			char	*q = lv_arena_alloc_aligned(a, 5, al);
+
+			assert(q && ((uintptr_t)q % al) == 0);
+			memset(q, 0, 5);
+		}
+		assert(lv_arena_alloc_aligned(a, 8, 3) == NULL);
+		assert(lv_arena_alloc_aligned(a, 8, 0) == NULL);
+		printf("lv_arena_alloc_aligned passed tests: %lu\r", i++);
+	}
+	{
+		t_arena	*c;
+		size_t	prev;
+
+		lv_arena_reset(a);
+		assert(a->size == DEFAULT_ARENA_SIZE);
+		for (int j = 0; j < 4096; j++)
+			assert(lv_arena_alloc_aligned(a, 1000, 8) != NULL);
+		prev = a->size;
+		for (c = a->next; c; c = c->next)
+		{
+			assert(c->size == (prev * 2 < LV_ARENA_MAX_CHUNK
+					? prev * 2 : LV_ARENA_MAX_CHUNK));
+			prev = c->size;
+		}
+		assert(prev == LV_ARENA_MAX_CHUNK);
+		char *huge = lv_arena_alloc_aligned(a, LV_ARENA_MAX_CHUNK * 2, 64);
+		assert(huge && ((uintptr_t)huge % 64) == 0);
+		memset(huge, 7, LV_ARENA_MAX_CHUNK * 2);
+		printf("lv_arena growth passed tests: %lu\r\n", i++);
+	}
+	lv_arena_destroy(a);
+}
+
+static void	*slab_worker(void *arg)
+{
+	void	**ring = arg;
+
+	for (int round = 0; round < 20; round++)
+	{
+		for (int j = 0; j < 1000; j++)
+		{
+			size_t	n = 1 + (size_t)((j * 131 + round) % LV_SLAB_MAX);
+			char	*p = lv_alloc(n);
+
+			assert(p && ((uintptr_t)p % DEF_ALIGN) == 0);
+			memset(p, (char)j, n);
+			lv_free(&ring[j]);
+			ring[j] = p;
+		}
+	}
+	return (NULL);
+}
+
+void	slab_tests()
+{
+	size_t		i = 0;
+	pthread_t	th[4];
+	void		*rings[4][1000] = {0};
+
+	{
+		for (size_t n = 0; n <= LV_SLAB_MAX; n += 1 + n / 4)
+		{
+			char	*p = lv_alloc(n);
+			size_t	cls = n <= LV_SLAB_MIN ? LV_SLAB_MIN : 1;
+
+			while (cls < n)
+				cls <<= 1;
+			assert(p && lv_slab_owns(p));
+			assert(lv_slab_size(p) == cls);
+			assert(((uintptr_t)p % cls) == 0);
+			memset(p, 0xAB, n);
+			void	*q = p;
+			lv_free(&q);
+			assert(q == NULL);
+			q = lv_alloc(n);
+			assert(q == p);
+			lv_free(&q);
+		}
+		void	*big = lv_alloc(LV_SLAB_MAX + 1);
+		assert(big && !lv_slab_owns(big));
+		assert(!lv_slab_owns(&i));
+		lv_free(&big);
+		assert(lv_slab_alloc(LV_SLAB_MAX + 1) == NULL);
+		printf("lv_slab passed tests: %lu\r", i++);
+	}
+	{
+		void	*ptrs[5000];
+
+		for (int j = 0; j < 5000; j++)
+		{
+			ptrs[j] = lv_alloc(24);
+			memset(ptrs[j], j & 0x7F, 24);
+		}
+		for (int j = 0; j < 5000; j++)
+			assert(((char *)ptrs[j])[23] == (j & 0x7F));
+		for (int j = 0; j < 5000; j += 2)
+			lv_free(&ptrs[j]);
+		for (int j = 1; j < 5000; j += 2)
+			assert(((char *)ptrs[j])[0] == (j & 0x7F));
+		for (int j = 1; j < 5000; j += 2)
+			lv_free(&ptrs[j]);
+		printf("lv_slab passed tests: %lu\r", i++);
+	}
+	{
+		for (int t = 0; t < 4; t++)
+			assert(!pthread_create(&th[t], NULL, slab_worker, rings[t]));
+		for (int t = 0; t < 4; t++)
+			assert(!pthread_join(th[t], NULL));
+		for (int t = 0; t < 4; t++)
+			for (int j = 0; j < 1000; j++)
+				lv_free(&rings[t][j]);
+		printf("lv_slab passed tests: %lu\r\n", i++);
+	}
+}
+
+void	regrow_tests()
+{
+	size_t	i = 0;
+
+	{
+		char	*p = lv_alloc(20);
+		char	*q;
+
+		memset(p, 'x', 20);
+		q = lv_extend_zero(p, 20, 12);
+		assert(q == p);
+		for (int j = 0; j < 32; j++)
+			assert(q[j] == (j < 20 ? 'x' : 0));
+		p = lv_extend(q, 32, 100);
+		assert(p && ((uintptr_t)p % DEF_ALIGN) == 0);
+		assert(!memcmp(p, "xxxxxxxxxxxxxxxxxxxx", 20) && !p[20] && !p[31]);
+		lv_free((void **)&p);
+		printf("lv_extend passed tests: %lu\r", i++);
+	}
+	for (size_t align = 32; align <= 4096; align *= 2)
+	{
+		unsigned char	*p = lv_alloc_align(3000, align);
+
+		memset(p, 0xAB, 3000);
+		p = lv_realloc(p, 3000, 3008);
+		assert(p && ((uintptr_t)p % DEF_ALIGN) == 0);
+		for (size_t j = 0; j < 3000; j++)
+			assert(p[j] == 0xAB);
+		lv_free((void **)&p);
+		p = lv_alloc_align(5000, align);
+		memset(p, 0xCD, 5000);
+		p = lv_extend_zero(p, 5000, 100000);
+		assert(p && ((uintptr_t)p % DEF_ALIGN) == 0);
+		for (size_t j = 0; j < 105000; j++)
+			assert(p[j] == (j < 5000 ? 0xCD : 0));
+		lv_free((void **)&p);
+		printf("lv_extend passed tests: %lu\r", i++);
+	}
+	{
+		size_t	n = LV_SLAB_MAX / 2;
+		char	*p = lv_alloc(n);
+
+		for (size_t j = 0; j < n; j++)
+			p[j] = (char)j;
+		for (int step = 0; step < 12; step++)
+		{
+			p = lv_extend_zero(p, n, n);
+			assert(p && ((uintptr_t)p % DEF_ALIGN) == 0);
+			for (size_t j = 0; j < n; j += 61)
+				assert(p[j] == (j < LV_SLAB_MAX / 2 ? (char)j : 0));
+			for (size_t j = n; j < n * 2; j += 7)
+				assert(p[j] == 0);
+			n *= 2;
+		}
+		p = lv_realloc(p, n, 100);
+		assert(p && p[99] == 99);
+		p = lv_recalloc(p, 100, 5000);
+		assert(p && p[99] == 99 && p[100] == 0 && p[4999] == 0);
+		lv_free((void **)&p);
+		assert(lv_realloc(lv_alloc(10), 10, 0) == NULL);
+		printf("lv_extend passed tests: %lu\r\n", i++);
+	}
+}
+
+void	huge_tests()
+{
+	size_t	i = 0;
+	size_t	mb = (size_t)1 << 20;
+
+	{
+		char	*p = lv_alloc_ex(3 * mb, LV_ALLOC_HUGE | LV_ALLOC_POPULATE);
+
+		assert(p && ((uintptr_t)p % 64) == 0);
+		for (size_t j = 0; j < 3 * mb; j += 4093)
+			assert(p[j] == 0);
+		memset(p, 'h', 3 * mb);
+		p = lv_extend_zero(p, 3 * mb, 13 * mb);
+		assert(p);
+		for (size_t j = 0; j < 16 * mb; j += 4093)
+			assert(p[j] == (j < 3 * mb ? 'h' : 0));
+		p = lv_realloc(p, 16 * mb, 100);
+		assert(p && p[0] == 'h' && p[99] == 'h');
+		lv_free((void **)&p);
+		assert(p == NULL);
+		p = lv_alloc_ex(10, LV_ALLOC_HUGE);
+		assert(p);
+		memset(p, 1, 10);
+		lv_free((void **)&p);
+		printf("lv_alloc_ex passed tests: %lu\r", i++);
+	}
+	{
+		char	*p = lv_alloc_ex(4 * mb, LV_ALLOC_HUGE);
+		char	*old = p;
+		size_t	pg = (size_t)sysconf(_SC_PAGESIZE);
+		char	*end = p - LV_HUGE_HDR + ((4 * mb + LV_HUGE_HDR + pg - 1)
+				& ~(pg - 1));
+		void	*block;
+
+		assert(p && ((uintptr_t)(p - LV_HUGE_HDR) % LV_HUGE_PAGE) == 0);
+		memset(p, 'a', 4 * mb);
+		block = mmap(end, pg, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS
+				| MAP_FIXED_NOREPLACE, -1, 0);
+		p = lv_extend_zero(p, 4 * mb, 6 * mb);
+		assert(p && (p != old || (block != MAP_FAILED && block != end)));
+		assert(((uintptr_t)(p - LV_HUGE_HDR) % LV_HUGE_PAGE) == 0);
+		for (size_t j = 0; j < 10 * mb; j += 4093)
+			assert(p[j] == (j < 4 * mb ? 'a' : 0));
+		if (block != MAP_FAILED)
+			munmap(block, pg);
+		lv_free((void **)&p);
+		printf("lv_alloc_ex passed tests: %lu\r", i++);
+	}
+	{
+		char	*p = lv_alloc(mb);
+
+		memset(p, 'm', mb);
+		p = lv_extend(p, mb, LV_HUGE_THRESHOLD);
+		assert(p && p[0] == 'm' && p[mb - 1] == 'm');
+		memset(p + mb, 'n', LV_HUGE_THRESHOLD);
+		p = lv_extend(p, mb + LV_HUGE_THRESHOLD, mb);
+		assert(p && p[mb] == 'n' && p[mb + LV_HUGE_THRESHOLD - 1] == 'n');
+		lv_free((void **)&p);
+		p = lv_alloc(LV_HUGE_THRESHOLD);
+		assert(p);
+		p[LV_HUGE_THRESHOLD - 1] = 1;
+		lv_free((void **)&p);
+		printf("lv_alloc_ex passed tests: %lu\r\n", i++);
+	}
+}
+
+void	alloc_stats_tests()
+{
+	size_t			i = 0;
+	t_alloc_stats	a = lv_alloc_stats();
+	t_alloc_stats	b;
+	t_alloc_sample	smp[LV_TRACE_RING];
+
+	if (!a.enabled)
+	{
+		char	*p = lv_alloc(24);
+
+		lv_alloc_trace(1);
+		lv_free((void **)&p);
+		lv_alloc_trace(0);
+		b = lv_alloc_stats();
+		assert(!b.live && !b.peak && !b.allocs && !b.arena_chunks);
+		assert(lv_alloc_samples(smp, LV_TRACE_RING) == 0);
+		printf("lv_alloc_stats passed tests: %lu\r\n", i++);
+		return ;
+	}
+	{
+		char	*p = lv_alloc(100);
+		char	*q = lv_alloc(100000);
+
+		b = lv_alloc_stats();
+		assert(b.allocs - a.allocs == 2);
+		assert(b.by_class[7] - a.by_class[7] == 1);
+		assert(b.by_class[17] - a.by_class[17] == 1);
+		assert(b.live - a.live >= 128 + 100000);
+		assert(b.live - a.live < 128 + 100000 + 4096);
+		assert(b.peak >= b.live);
+		printf("lv_alloc_stats passed tests: %lu\r", i++);
+		memset(p, 'a', 100);
+		p = lv_extend(p, 100, 20);
+		p = lv_extend(p, 120, 3880);
+		assert(p && p[0] == 'a' && p[99] == 'a');
+		a = lv_alloc_stats();
+		assert(a.extend_inplace - b.extend_inplace == 1);
+		assert(a.extend_copies - b.extend_copies == 1);
+		assert(a.bytes_copied - b.bytes_copied == 120);
+		assert(a.allocs - b.allocs == 1 && a.frees - b.frees == 1);
+		lv_free((void **)&p);
+		lv_free((void **)&q);
+		a = lv_alloc_stats();
+		assert(a.frees - b.frees == 3);
+		assert(b.live - a.live >= 128 + 100000);
+		printf("lv_alloc_stats passed tests: %lu\r", i++);
+	}
+	{
+		t_arena	*ar;
+
+		a = lv_alloc_stats();
+		ar = lv_arena_create(((size_t)4 << 20) + 4096);
+		assert(ar && lv_arena_alloc(ar, 1000));
+		b = lv_alloc_stats();
+		assert(b.arena_chunks - a.arena_chunks == 1);
+		lv_arena_destroy(ar);
+		b = lv_alloc_stats();
+		assert(b.arena_chunks == a.arena_chunks);
+		printf("lv_alloc_stats passed tests: %lu\r", i++);
+	}
+	{
+		void	*p[3];
+		size_t	n;
+
+		lv_alloc_trace(1);
+		p[0] = lv_alloc(10);
+		p[1] = lv_alloc(3000);
+		p[2] = lv_alloc(77);
+		lv_alloc_trace(0);
+		for (int j = 0; j < 3; j++)
+			lv_free(&p[j]);
+		n = lv_alloc_samples(smp, LV_TRACE_RING);
+		assert(n >= 3);
+		assert(smp[n - 3].size == 10 && smp[n - 2].size == 3000);
+		assert(smp[n - 1].size == 77 && smp[n - 1].depth > 0);
+		assert(lv_alloc_samples(smp, 1) == 1 && smp[0].size == 77);
+		printf("lv_alloc_stats passed tests: %lu\r\n", i++);
+	}
+}
+
+void	calloc_fresh_tests()
+{
+	size_t	i = 0;
+	size_t	mb = (size_t)1 << 20;
+	size_t	pg = (size_t)sysconf(_SC_PAGESIZE);
+
+	{
+		t_u8			*p = lv_calloc(64, mb);
+		unsigned char	vec[(64 << 20) / 4096 + 2];
+		t_u8			*base = (t_u8 *)((uintptr_t)p & ~(pg - 1));
+		size_t			res = 0;
+
+		assert(p && pg == 4096);
+		assert(mincore(base, 64 * mb, vec) == 0);
+		for (size_t j = 0; j < 64 * mb / pg; j++)
+			res += vec[j] & 1;
+		assert(res < 64 * mb / pg / 2);
+		for (size_t j = 0; j < 64 * mb; j += 4093)
+			assert(p[j] == 0);
+		lv_free((void **)&p);
+		printf("lv_calloc passed tests: %lu\r", i++);
+	}
+	{
+		char	*p = lv_alloc(200000);
+
+		memset(p, 'x', 200000);
+		lv_free((void **)&p);
+		p = lv_calloc(200000, 1);
+		for (size_t j = 0; j < 200000; j++)
+			assert(p[j] == 0);
+		lv_free((void **)&p);
+		p = lv_alloc(1000);
+		memset(p, 'x', 1000);
+		lv_free((void **)&p);
+		p = lv_calloc(10, 100);
+		for (size_t j = 0; j < 1000; j++)
+			assert(p[j] == 0);
+		lv_free((void **)&p);
+		printf("lv_calloc passed tests: %lu\r", i++);
+	}
+	{
+		char	*p = lv_alloc_ex(3 * mb, LV_ALLOC_HUGE);
+
+		memset(p, 'y', 3 * mb);
+		p = lv_realloc(p, 3 * mb, mb + 100);
+		assert(p && p[mb + 99] == 'y');
+		p = lv_extend_zero(p, 1000, 5 * mb);
+		assert(p && p[999] == 'y');
+		for (size_t j = 1000; j < 5 * mb + 1000; j++)
+			assert(p[j] == 0);
+		lv_free((void **)&p);
+		p = lv_alloc(mb);
+		memset(p, 'z', mb);
+		p = lv_extend_zero(p, mb, LV_HUGE_THRESHOLD);
+		assert(p && p[mb - 1] == 'z');
+		for (size_t j = mb; j < mb + LV_HUGE_THRESHOLD; j += 511)
+			assert(p[j] == 0);
+		lv_free((void **)&p);
+		printf("lv_calloc passed tests: %lu\r\n", i++);
+	}
+}
+
+void	memrev_tests()
+{
+	size_t			i = 0;
+	const t_u32		levels[] = {LV_CPU_SSE2, LV_CPU_AVX2, LV_CPU_AVX512};
+	const size_t	widths[] = {1, 2, 3, 4, 8, 12, 16, 40};
+	t_u8			*a = lv_alloc(8 * 700 + 64);
+	t_u8			*r = lv_alloc(8 * 700 + 64);
+
+	for (size_t l = 0; l < sizeof(levels) / sizeof(*levels); l++)
+	{
+		lv_cpu_dispatch(levels[l]);
+		for (size_t w = 0; w < sizeof(widths) / sizeof(*widths); w++)
+		{
+			for (size_t n = 0; n * widths[w] <= 8 * 700; n += 1 + n / 9)
+			{
+				size_t	ws = widths[w];
+				t_u8	*p = a + (n & 3);
+
+				for (size_t k = 0; k < n * ws + 8; k++)
+					p[k] = (t_u8)(k * 7 + n);
+				for (size_t e = 0; e < n; e++)
+					memcpy(r + e * ws, p + (n - 1 - e) * ws, ws);
+				memcpy(r + n * ws, p + n * ws, 8);
+				lv_memrev(p, n, ws);
+				assert(memcmp(p, r, n * ws + 8) == 0);
+			}
+		}
+		printf("lv_memrev passed tests: %lu\r", i++);
+	}
+	lv_cpu_dispatch(LV_CPU_SSE2 | LV_CPU_AVX2 | LV_CPU_AVX512);
+	lv_memrev(NULL, 10, 4);
+	lv_memrev(a, 1, 4);
+	lv_free((void **)&a);
+	lv_free((void **)&r);
+	printf("lv_memrev passed tests: %lu\r\n", i++);
+}
+
+void	dispatch_tests()
+{
+	size_t		i = 0;
+	const t_u32	levels[] = {LV_CPU_SSE2, LV_CPU_AVX2, LV_CPU_AVX512};
+	const size_t	sizes[] = {0, 1, 7, 15, 16, 31, 33, 63, 64, 65, 127,
+		129, 255, 257, 1000, 4099};
+
+	LV_DEFER char *a = lv_alloc(L3_TEST * 2);
+	LV_DEFER char *b = lv_alloc(L3_TEST * 2);
+	LV_DEFER char *c = lv_alloc(L3_TEST * 2);
+
+	for (size_t l = 0; l < sizeof(levels) / sizeof(*levels); l++)
+	{
+		lv_cpu_dispatch(levels[l]);
+		for (size_t s = 0; s < sizeof(sizes) / sizeof(*sizes); s++)
+		{
+			for (size_t da = 0; da < 3; da++)
+			{
+				for (size_t sa = 0; sa < 3; sa++)
+				{
+					size_t	n = sizes[s];
+					char	*d = b + da * 37;
+					char	*o = a + sa * 21;
+
+					for (size_t k = 0; k < L3_TEST * 2; k++)
+						a[k] = (char)(k * 131 + l);
+					memset(b, 0x5A, L3_TEST * 2);
+					memset(c, 0x5A, L3_TEST * 2);
+					assert(lv_memcpy(d, o, n) == d);
+					memcpy(c + da * 37, o, n);
+					assert(memcmp(b, c, L3_TEST * 2) == 0);
+					assert(lv_memcmp(d, o, n) == 0);
+					if (n)
+					{
+						d[n - 1] ^= 0x40;
+						assert((lv_memcmp(d, o, n) > 0)
+							== (memcmp(d, o, n) > 0));
+						assert(lv_memcmp(d, o, n) != 0);
+						d[n - 1] ^= 0x40;
+						assert(lv_memchr(d, d[n - 1], n)
+							== memchr(d, d[n - 1], n));
+					}
+					assert(lv_memchr(d, 0x7F, n) == memchr(d, 0x7F, n));
+					assert(lv_memset(d, (int)(n & 0xFF), n) == d);
+					memset(c + da * 37, (int)(n & 0xFF), n);
+					assert(memcmp(b, c, L3_TEST * 2) == 0);
+					memcpy(c, b, L3_TEST * 2);
+					assert(lv_memmove(b + sa, b + da * 5, n) == b + sa
+						|| (n && sa == da * 5));
+					memmove(c + sa, c + da * 5, n);
+					assert(memcmp(b, c, L3_TEST * 2) == 0);
+					lv_memmove(b + sa * 64, b + da * 64, n);
+					memmove(c + sa * 64, c + da * 64, n);
+					assert(memcmp(b, c, L3_TEST * 2) == 0);
+				}
+			}
+		}
+		printf("dispatch passed tests: %lu\r", i++);
+	}
+	lv_cpu_dispatch(LV_CPU_SSE2 | LV_CPU_AVX2 | LV_CPU_AVX512);
+	printf("dispatch passed tests: %lu\r\n", i++);
+}
+
+void	nt_tests()
+{
+	size_t		i = 0;
+	const t_u32	levels[] = {LV_CPU_SSE2, LV_CPU_AVX2, LV_CPU_AVX512};
+	const size_t	sizes[] = {0, 1, 63, 64, 255, 256, 257, 1000, 4099, 9000};
+	const size_t	saved = g_lv_nt_threshold;
+
+	LV_DEFER char *a = lv_alloc(L3_TEST * 2);
+	LV_DEFER char *b = lv_alloc(L3_TEST * 2);
+	LV_DEFER char *c = lv_alloc(L3_TEST * 2);
+
+	for (size_t k = 0; k < L3_TEST * 2; k++)
+		a[k] = (char)(k * 29 + 3);
+	g_lv_nt_threshold = 256;
+	for (size_t l = 0; l < sizeof(levels) / sizeof(*levels); l++)
+	{
+		lv_cpu_dispatch(levels[l]);
+		for (size_t s = 0; s < sizeof(sizes) / sizeof(*sizes); s++)
+		{
+			for (size_t off = 0; off < 3; off++)
+			{
+				size_t	n = sizes[s];
+				char	*d = b + off * 13;
+				char	*o = a + off * 7;
+
+				memset(b, 0x11, L3_TEST * 2);
+				memset(c, 0x11, L3_TEST * 2);
+				assert(lv_memcpy_nt(d, o, n) == d);
+				memcpy(c + off * 13, o, n);
+				assert(memcmp(b, c, L3_TEST * 2) == 0);
+				assert(lv_memcpy(d + 1, o, n) == d + 1);
+				memcpy(c + off * 13 + 1, o, n);
+				assert(memcmp(b, c, L3_TEST * 2) == 0);
+				assert(lv_memset(d, 0xC3, n) == d);
+				memset(c + off * 13, 0xC3, n);
+				assert(memcmp(b, c, L3_TEST * 2) == 0);
+			}
+		}
+		printf("nt copy passed tests: %lu\r", i++);
+	}
+	g_lv_nt_threshold = saved;
+	lv_cpu_dispatch(LV_CPU_SSE2 | LV_CPU_AVX2 | LV_CPU_AVX512);
+	assert(lv_memcpy_nt(NULL, a, 1) == NULL);
+	assert(lv_memcpy_nt(b, a, 0) == b);
+	printf("nt copy passed tests: %lu\r\n", i++);
+}
+
+void	small_copy_tests()
+{
+	size_t	i = 0;
+	char	a[LV_SMALL_COPY * 2 + 64];
+	char	b[LV_SMALL_COPY * 2 + 64];
+
+	for (size_t n = 0; n <= LV_SMALL_COPY; n++)
+	{
+		for (size_t off = 0; off < 24; off += 5)
+		{
+			for (size_t k = 0; k < sizeof(a); k++)
+				a[k] = b[k] = (char)(k * 7 + n);
+			assert(_lv_memcpy_small(a + LV_SMALL_COPY + 8 + off, a + 3, n)
+				== a + LV_SMALL_COPY + 8 + off);
+			memcpy(b + LV_SMALL_COPY + 8 + off, b + 3, n);
+			assert(memcmp(a, b, sizeof(a)) == 0);
+			assert(lv_memmove(a + off, a + 11, n) == a + off || !n
+				|| off == 11);
+			memmove(b + off, b + 11, n);
+			assert(memcmp(a, b, sizeof(a)) == 0);
+			lv_memmove(a + 13, a + off, n);
+			memmove(b + 13, b + off, n);
+			assert(memcmp(a, b, sizeof(a)) == 0);
+		}
+	}
+	printf("small copy passed tests: %lu\r\n", i++);
+}
+
+static const char	*ref_memrchr(const char *p, int c, size_t n)
+{
+	while (n--)
+		if (p[n] == (char)c)
+			return (p + n);
+	return (NULL);
+}
+
+void	memchr_tests()
+{
+	size_t		i = 0;
+	const t_u32	levels[] = {LV_CPU_SSE2, LV_CPU_AVX2, LV_CPU_AVX512};
+	char		buf[512];
+	long		pg = sysconf(_SC_PAGESIZE);
+	char		*map;
+
+	for (size_t l = 0; l < sizeof(levels) / sizeof(*levels); l++)
+	{
+		lv_cpu_dispatch(levels[l]);
+		for (size_t off = 0; off < 70; off++)
+		{
+			for (size_t n = 0; n < 400; n += (n < 140) ? 1 : 13)
+			{
+				memset(buf, 'a', sizeof(buf));
+				assert(lv_memchr(buf + off, 'b', n) == NULL);
+				assert(lv_memrchr(buf + off, 'b', n) == NULL);
+				if (off)
+					buf[off - 1] = 'b';
+				buf[off + n] = 'b';
+				assert(lv_memchr(buf + off, 'b', n) == NULL);
+				assert(lv_memrchr(buf + off, 'b', n) == NULL);
+				for (size_t k = 0; k < n; k += 1 + k / 3)
+				{
+					buf[off + k] = 'c';
+					buf[off + n - 1 - k / 2] = 'c';
+					assert(lv_memchr(buf + off, 'c', n)
+						== memchr(buf + off, 'c', n));
+					assert(lv_memrchr(buf + off, 'c', n)
+						== ref_memrchr(buf + off, 'c', n));
+				}
+			}
+		}
+		printf("memchr/memrchr passed tests: %lu\r", i++);
+	}
+	map = mmap(NULL, (size_t)pg * 3, PROT_READ | PROT_WRITE,
+			MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	assert(map != MAP_FAILED);
+	assert(mprotect(map, (size_t)pg, PROT_NONE) == 0);
+	assert(mprotect(map + pg * 2, (size_t)pg, PROT_NONE) == 0);
+	memset(map + pg, 'a', (size_t)pg);
+	for (size_t l = 0; l < sizeof(levels) / sizeof(*levels); l++)
+	{
+		lv_cpu_dispatch(levels[l]);
+		for (size_t n = 1; n < 200; n++)
+		{
+			assert(lv_memchr(map + pg * 2 - n, 'z', n) == NULL);
+			assert(lv_memrchr(map + pg * 2 - n, 'z', n) == NULL);
+			assert(lv_memchr(map + pg, 'z', n) == NULL);
+			assert(lv_memrchr(map + pg, 'z', n) == NULL);
+		}
+	}
+	munmap(map, (size_t)pg * 3);
+	lv_cpu_dispatch(LV_CPU_SSE2 | LV_CPU_AVX2 | LV_CPU_AVX512);
+	assert(lv_memrchr(NULL, 'a', 4) == NULL);
+	assert(lv_memrchr(buf, 'a', 0) == NULL);
+	printf("memchr/memrchr passed tests: %lu\r\n", i++);
+}
+
+static int	sgn(long x)
+{
+	return ((x > 0) - (x < 0));
+}
+
+void	memcmp_simd_tests()
+{
+	size_t		i = 0;
+	const t_u32	levels[] = {LV_CPU_SSE2, LV_CPU_AVX2, LV_CPU_AVX512};
+	char		x[700];
+	char		y[700];
+
+	for (size_t l = 0; l < sizeof(levels) / sizeof(*levels); l++)
+	{
+		lv_cpu_dispatch(levels[l]);
+		for (size_t n = 0; n < 600; n += (n < 300) ? 1 : 37)
+		{
+			for (size_t off = 0; off < 5; off++)
+			{
+				char	*a = x + off * 3;
+				char	*b = y + off * 11;
+
+				for (size_t k = 0; k < n; k++)
+					a[k] = b[k] = (char)(k * 13 + n);
+				assert(lv_memcmp(a, b, n) == 0);
+				assert(lv_memeq(a, b, n));
+				for (size_t k = 0; k < n; k += 1 + k / 4)
+				{
+					b[k] = (char)(a[k] + 1 + (char)(k & 0x7F));
+					assert(sgn(lv_memcmp(a, b, n)) == sgn(memcmp(a, b, n)));
+					assert(lv_memcmp(a, b, n) == (t_u8)a[k] - (t_u8)b[k]);
+					assert(!lv_memeq(a, b, n));
+					assert(lv_memeq(a, b, k));
+					b[k] = a[k];
+				}
+			}
+		}
+		printf("memcmp/memeq passed tests: %lu\r", i++);
+	}
+	lv_cpu_dispatch(LV_CPU_SSE2 | LV_CPU_AVX2 | LV_CPU_AVX512);
+	assert(lv_memeq(NULL, NULL, 4));
+	assert(!lv_memeq(x, NULL, 4));
+	assert(lv_memeq(x, y, 0));
+	printf("memcmp/memeq passed tests: %lu\r\n", i++);
+}
+
+static const char	*ref_any(const char *p, size_t n, const char *set,
+	size_t setn, int mode)
+{
+	for (size_t k = 0; k < n; k++)
+	{
+		size_t	at = (mode & LV_SET_REV) ? n - 1 - k : k;
+		int		in = memchr(set, p[at], setn) != NULL;
+
+		if (in == !(mode & LV_SET_NOT))
+			return (p + at);
+	}
+	return (NULL);
+}
+
+void	memchr_any_tests()
+{
+	size_t		i = 0;
+	const t_u32	levels[] = {LV_CPU_SSE2, LV_CPU_AVX2, LV_CPU_AVX512};
+	const char	*sets[] = {" ", " \t\n", "\x80\xff\x7f", "aeiouAEIOU",
+		"\x00\x10\x20\x90\xa0"};
+	const size_t	setn[] = {1, 3, 3, 10, 5};
+	char		buf[300];
+	t_byteset	bs;
+
+	for (size_t l = 0; l < sizeof(levels) / sizeof(*levels); l++)
+	{
+		lv_cpu_dispatch(levels[l]);
+		for (size_t st = 0; st < sizeof(sets) / sizeof(*sets); st++)
+		{
+			lv_byteset_init(&bs, sets[st], setn[st]);
+			for (size_t seed = 0; seed < 40; seed++)
+			{
+				for (size_t k = 0; k < sizeof(buf); k++)
+				{
+					size_t	h = (k * 2654435761U + seed * 97) >> 7;
+
+					buf[k] = (h % 5 < (seed % 4) + 1)
+						? sets[st][h % setn[st]] : (char)(h & 0xFF);
+				}
+				for (size_t n = 0; n < 260; n += 1 + n / 16)
+				{
+					for (int mode = 0; mode < 4; mode++)
+					{
+						void	*r;
+
+						if (mode == 0)
+							r = lv_memchr_any(buf + 3, n, &bs);
+						else if (mode == LV_SET_NOT)
+							r = lv_memchr_not(buf + 3, n, &bs);
+						else if (mode == LV_SET_REV)
+							r = lv_memrchr_any(buf + 3, n, &bs);
+						else
+							r = lv_memrchr_not(buf + 3, n, &bs);
+						assert(r == ref_any(buf + 3, n, sets[st], setn[st],
+								mode));
+					}
+				}
+			}
+		}
+		printf("memchr_any passed tests: %lu\r", i++);
+	}
+	lv_cpu_dispatch(LV_CPU_SSE2 | LV_CPU_AVX2 | LV_CPU_AVX512);
+	assert(lv_memchr_any(NULL, 4, &bs) == NULL);
+	assert(lv_memchr_not(buf, 4, NULL) == NULL);
+	printf("memchr_any passed tests: %lu\r\n", i++);
+}
+
+static void	*ref_memmem(const char *h, size_t n, const char *nd, size_t l)
+{
+	for (size_t i = 0; i + l <= n; i++)
+		if (!memcmp(h + i, nd, l))
+			return ((void *)(h + i));
+	return (NULL);
+}
+
+void	memmem_tests()
+{
+	size_t		i = 0;
+	const t_u32	levels[] = {LV_CPU_SSE2, LV_CPU_AVX2, LV_CPU_AVX512};
+	char		hay[400];
+	char		nd[80];
+	t_searcher	s;
+
+	for (size_t l = 0; l < sizeof(levels) / sizeof(*levels); l++)
+	{
+		lv_cpu_dispatch(levels[l]);
+		for (size_t seed = 0; seed < 24; seed++)
+		{
+			size_t	alpha = 2 + seed % 3;
+
+			for (size_t k = 0; k < sizeof(hay); k++)
+				hay[k] = (char)('a' + ((k * 2654435761U + seed * 131) >> 9)
+						% alpha);
+			for (size_t len = 0; len < sizeof(nd); len += 1 + len / 12)
+			{
+				size_t	from = (seed * 37 + len * 11) % (sizeof(hay) - len);
+
+				memcpy(nd, hay + from, len);
+				if (seed & 1 && len)
+					nd[len / 2] = (char)('a' + (nd[len / 2] - 'a' + 1) % alpha);
+				if (seed % 6 == 4)
+					for (size_t k = 0; k < len; k++)
+						nd[k] = (char)('a' + (k % (seed % 5 + 1)) % alpha);
+				lv_searcher_init(&s, nd, len);
+				for (size_t n = 0; n <= sizeof(hay) - 3; n += 1 + n / 8)
+				{
+					void	*r = ref_memmem(hay + 3, n, nd, len);
+
+					assert(lv_memmem(hay + 3, n, nd, len) == r);
+					assert(lv_searcher_find(&s, hay + 3, n) == r);
+				}
+			}
+		}
+		printf("lv_memmem passed tests: %lu\r", i++);
+	}
+	lv_cpu_dispatch(LV_CPU_SSE2 | LV_CPU_AVX2 | LV_CPU_AVX512);
+	{
+		const char	*h = "the quick brown fox jumps over the lazy dog";
+		const char	*lng = "abcabcabcabcabcabcabcabcabcabcabcabcabcabd";
+		char		big[4096];
+
+		assert(lv_memmem(h, strlen(h), "lazy", 4) == h + 35);
+		assert(lv_memmem(h, strlen(h), "g", 1) == h + strlen(h) - 1);
+		assert(lv_memmem(h, strlen(h), "", 0) == h);
+		assert(lv_memmem(h, 3, "the ", 4) == NULL);
+		assert(lv_memmem(NULL, 3, "a", 1) == NULL);
+		assert(lv_memmem(h, 3, NULL, 1) == NULL);
+		for (size_t k = 0; k < sizeof(big); k++)
+			big[k] = "abc"[k % 3];
+		memcpy(big + sizeof(big) - strlen(lng), lng, strlen(lng));
+		assert(lv_memmem(big, sizeof(big), lng, strlen(lng))
+			== big + sizeof(big) - strlen(lng));
+		lv_searcher_init(&s, lng, strlen(lng));
+		assert(lv_searcher_find(&s, big, sizeof(big) - 1) == NULL);
+		assert(lv_searcher_find(NULL, big, sizeof(big)) == NULL);
+		printf("lv_memmem passed tests: %lu\r\n", i++);
+	}
+}
+
 int main()
 {
 	memcpy_tests();
@@ -533,6 +1492,22 @@ int main()
 	memcmp_tests();
 	memformat_tests();
 	arena_allocation_tests();
+	arena_thread_tests();
+	arena_mark_tests();
+	arena_aligned_tests();
+	slab_tests();
+	regrow_tests();
+	huge_tests();
+	alloc_stats_tests();
+	calloc_fresh_tests();
+	dispatch_tests();
+	nt_tests();
+	small_copy_tests();
+	memchr_tests();
+	memcmp_simd_tests();
+	memchr_any_tests();
+	memmem_tests();
+	memrev_tests();
 	printf("[TESTER] All mem test passed\n");
 	return (0);
 }
@@ -0,0 +1,142 @@
+#include <llv/pool.h>
+#include <llv/alloc.h>
+#include <llv/macros.h>
+#include <string.h>
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+static int	cmp_int(const void *a, const void *b)
+{
+	int	x = *(const int *)a;
+	int	y = *(const int *)b;
+
+	return ((x > y) - (x < y));
+}
+
+static void	sum_int(void *acc, const void *elem, void *ctx)
+{
+	(void)ctx;
+	*(long *)acc += *(const int *)elem;
+}
+
+static void	sum_long(void *acc, const void *part, void *ctx)
+{
+	(void)ctx;
+	*(long *)acc += *(const long *)part;
+}
+
+static void	sum_dbl(void *acc, const void *elem, void *ctx)
+{
+	(void)ctx;
+	*(double *)acc += *(const int *)elem * 0.1;
+}
+
+static void	merge_dbl(void *acc, const void *part, void *ctx)
+{
+	(void)ctx;
+	*(double *)acc += *(const double *)part;
+}
+
+static void	square(void *chunk, size_t n, size_t first, void *ctx)
+{
+	int	*p = chunk;
+
+	(void)ctx;
+	for (size_t j = 0; j < n; j++)
+		p[j] = (int)((first + j) % 1000) * (int)((first + j) % 1000);
+}
+
+static void	count(size_t task, void *ctx)
+{
+	(void)task;
+	__atomic_add_fetch((size_t *)ctx, 1, __ATOMIC_RELAXED);
+}
+
+static t_pool	*g_nested;
+
+static void	nested(size_t task, void *ctx)
+{
+	(void)task;
+	lv_pool_run(g_nested, 10, count, ctx);
+}
+
+static void	par_vec_tests(t_pool *pool, size_t *i)
+{
+	size_t	sizes[] = {0, 1, 1000, LV_PAR_MIN - 1, LV_PAR_MIN, LV_PAR_MIN + 1,
+		3 * LV_PAR_MIN + 7, 20 * LV_PAR_MIN};
+
+	for (size_t s = 0; s < sizeof(sizes) / sizeof(*sizes); s++)
+	{
+		size_t	n = sizes[s];
+		t_vec	v = lv_vec(n + 1, sizeof(int));
+		t_vec	ref = lv_vec(n + 1, sizeof(int));
+		long	sum = 0;
+		long	par = 0;
+		double	d1 = 0;
+		double	d2 = 0;
+
+		lv_vec_resize(&v, n, NULL);
+		lv_vec_par_for(pool, &v, square, NULL);
+		for (size_t j = 0; j < n; j++)
+			assert(((int *)v.data)[j] == (int)((j % 1000) * (j % 1000)));
+		for (size_t j = 0; j < n; j++)
+			((int *)v.data)[j] = rand() % (s % 2 ? 50 : 1000000);
+		lv_vec_extend_from(&ref, &v);
+		lv_vec_reduce(&v, &sum, sum_int, NULL);
+		assert(lv_vec_par_reduce(pool, &v, &par, sizeof(par), sum_int,
+				sum_long, NULL));
+		assert(par == sum);
+		assert(lv_vec_par_reduce(pool, &v, &d1, sizeof(d1), sum_dbl,
+				merge_dbl, NULL));
+		assert(lv_vec_par_reduce(NULL, &v, &d2, sizeof(d2), sum_dbl,
+				merge_dbl, NULL));
+		assert(d1 == d2);
+		lv_vec_sort(&ref, cmp_int);
+		assert(lv_vec_par_sort(pool, &v, cmp_int));
+		assert(!memcmp(v.data, ref.data, n * sizeof(int)));
+		lv_vec_free(&v);
+		lv_vec_free(&ref);
+		printf("lv_vec_par passed tests: %lu\r", (*i)++);
+	}
+}
+
+void	pool_tests()
+{
+	size_t	i = 0;
+	t_pool	*pools[4];
+
+	pools[0] = lv_pool_create(4, LV_POOL_DETERMINISTIC);
+	pools[1] = lv_pool_create(1, 0);
+	pools[2] = lv_pool_create(2, 0);
+	pools[3] = lv_pool_create(5, 0);
+	assert(lv_pool_size(pools[0]) == 1);
+	assert(lv_pool_size(pools[3]) == 5);
+	assert(lv_pool_default() == lv_pool_default());
+	for (int p = 0; p < 4; p++)
+	{
+		size_t	n = 0;
+
+		assert(pools[p]);
+		lv_pool_run(pools[p], 1000, count, &n);
+		assert(n == 1000);
+		n = 0;
+		g_nested = pools[p];
+		lv_pool_run(pools[p], 50, nested, &n);
+		assert(n == 500);
+		par_vec_tests(pools[p], &i);
+		lv_pool_destroy(pools[p]);
+	}
+	lv_pool_destroy(NULL);
+	assert(!lv_vec_par_sort(NULL, NULL, cmp_int));
+	assert(!lv_vec_par_reduce(NULL, NULL, &i, sizeof(i), sum_int,
+			sum_long, NULL));
+	printf("lv_pool passed tests: %lu\r\n", i++);
+}
+
+int main()
+{
+	pool_tests();
+	printf("[TESTER] All pool tests passed\n");
+	return (0);
+}
@@ -0,0 +1,161 @@
+#include <llv/tstr.h>
+#include <llv/alloc.h>
+#include <llv/macros.h>
+#include <string.h>
+#include <assert.h>
+#include <stdio.h>
+
+static void	check(const t_string *s, const char *exp)
+{
+	assert(s->len == strlen(exp));
+	assert(!memcmp(lv_tstr_borrow(s), exp, s->len + 1));
+	if (s->len > LV_TSTR_SSO)
+		assert(s->heap);
+}
+
+void	tstr_sso_tests()
+{
+	size_t	i = 0;
+	char	ref[64];
+
+	assert(sizeof(t_string) == 32);
+	{
+		t_string	s = {0};
+
+		check(&s, "");
+		assert(!s.heap);
+		lv_tstr_pushstr(&s, "abc");
+		check(&s, "abc");
+		assert(!s.heap);
+		lv_tstr_free(&s);
+		check(&s, "");
+		printf("lv_tstr zeroed passed tests: %lu\r", i++);
+	}
+	{
+		t_string	s = lv_tstr_from_slice("abcdefghijklmnopqrstuvwxyz", 23);
+		t_string	t = lv_tstr_from_slice("abcdefghijklmnopqrstuvwxyz", 24);
+		t_string	u = s;
+		t_string	v = lv_tstr_new(LV_TSTR_SSO + 1);
+
+		assert(!s.heap && t.heap);
+		check(&s, "abcdefghijklmnopqrstuvw");
+		check(&t, "abcdefghijklmnopqrstuvwx");
+		check(&u, "abcdefghijklmnopqrstuvw");
+		assert(!lv_tstr_new(LV_TSTR_SSO).heap);
+		assert(v.heap && v.alloc_size == LV_TSTR_SSO + 2);
+		lv_tstr_free(&v);
+		v = lv_tstr_new(-1);
+		check(&v, "");
+		lv_tstr_free(&s);
+		lv_tstr_free(&t);
+		printf("lv_tstr boundary passed tests: %lu\r", i++);
+	}
+	{
+		t_string	s = lv_tstr_new(0);
+
+		memset(ref, 0, sizeof(ref));
+		for (int j = 0; j < 40; j++)
+		{
+			lv_tstr_push(&s, (char)('a' + j % 26));
+			ref[j] = (char)('a' + j % 26);
+			check(&s, ref);
+			assert(!!s.heap == (s.len > LV_TSTR_SSO));
+		}
+		lv_tstr_free(&s);
+		s = lv_tstr_from_cstr("0123456789");
+		lv_tstr_pushstr(&s, "0123456789012");
+		assert(!s.heap);
+		lv_tstr_pushstr(&s, "x");
+		assert(s.heap);
+		check(&s, "01234567890123456789012x");
+		lv_tstr_free(&s);
+		s = lv_tstr_from_cstr("hello");
+		lv_tstr_insert(&s, "XY", 2);
+		check(&s, "heXYllo");
+		assert(!s.heap);
+		lv_tstr_insert(&s, "0123456789abcdefghij", 7);
+		assert(s.heap);
+		check(&s, "heXYllo0123456789abcdefghij");
+		lv_tstr_insert(&s, "!", s.len);
+		check(&s, "heXYllo0123456789abcdefghij!");
+		lv_tstr_free(&s);
+		s = lv_tstr_from_cstr(NULL);
+		lv_tstr_repeat(&s, "ab", 11);
+		assert(!s.heap);
+		lv_tstr_repeat(&s, "ab", 1);
+		assert(s.heap);
+		check(&s, "abababababababababababab");
+		lv_tstr_free(&s);
+		s = lv_tstr_from_cstr("0123456789");
+		lv_tstr_reserve(&s, LV_TSTR_SSO - 10);
+		assert(!s.heap);
+		lv_tstr_reserve(&s, LV_TSTR_SSO - 9);
+		assert(s.heap && s.alloc_size >= LV_TSTR_SSO + 2);
+		check(&s, "0123456789");
+		lv_tstr_free(&s);
+		printf("lv_tstr spill passed tests: %lu\r", i++);
+	}
+	{
+		t_string	s = lv_tstr_from_cstr("abcdefghijklmnopqrstuvwxyz");
+
+		lv_tstr_fit(&s);
+		assert(s.heap && s.alloc_size == 27);
+		check(&s, "abcdefghijklmnopqrstuvwxyz");
+		while (s.len > LV_TSTR_SSO)
+			lv_tstr_pop(&s);
+		assert(s.heap);
+		lv_tstr_fit(&s);
+		assert(!s.heap);
+		check(&s, "abcdefghijklmnopqrstuvw");
+		lv_tstr_fit(&s);
+		check(&s, "abcdefghijklmnopqrstuvw");
+		lv_tstr_push(&s, 'x');
+		assert(s.heap);
+		check(&s, "abcdefghijklmnopqrstuvwx");
+		lv_tstr_free(&s);
+		printf("lv_tstr_fit passed tests: %lu\r", i++);
+	}
+	for (int heap = 0; heap < 2; heap++)
+	{
+		t_string	s = lv_tstr_from_cstr(heap ? "  \t trimmed on the heap too \t "
+				: "  short  ");
+		const char	*exp = heap ? "trimmed on the heap too" : "short";
+		char		*dup;
+
+		assert(!!s.heap == heap);
+		lv_tstr_trim(&s, " \t");
+		check(&s, exp);
+		if (!heap)
+			assert(!memcmp(s.sso + s.len, "\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0\0",
+					LV_TSTR_SSO + 1 - s.len));
+		assert(lv_tstr_instr(&s, "rt") == (heap ? -1 : 3));
+		assert(lv_tstr_instr(&s, "heap") == (heap ? 15 : -1));
+		assert(lv_tstr_instr(&s, "") == 0);
+		dup = lv_tstr_dup_cstr(&s);
+		assert(dup && !strcmp(dup, exp));
+		lv_free((void **)&dup);
+		assert(lv_tstr_pop(&s) == exp[strlen(exp) - 1]);
+		assert(s.len == strlen(exp) - 1 && !lv_tstr_borrow(&s)[s.len]);
+		lv_tstr_clear(&s);
+		check(&s, "");
+		assert(!!s.heap == heap);
+		assert(lv_tstr_pop(&s) == 0);
+		lv_tstr_pushstr(&s, "again");
+		check(&s, "again");
+		lv_tstr_free(&s);
+		assert(!s.heap && !s.len);
+		s = lv_tstr_from_cstr("  \t ");
+		lv_tstr_trim(&s, " \t");
+		check(&s, "");
+		lv_tstr_free(&s);
+		printf("lv_tstr trim/pop/clear passed tests: %lu\r", i++);
+	}
+	printf("lv_tstr passed tests: %lu\r\n", i++);
+}
+
+int main()
+{
+	tstr_sso_tests();
+	printf("[TESTER] All tstr tests passed\n");
+	return (0);
+}
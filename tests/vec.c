@@ -0,0 +1,506 @@
+#include <llv/vec.h>
+#include <llv/alloc.h>
+#include <llv/macros.h>
+#include <string.h>
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+void	vec_growth_tests()
+{
+	size_t	i = 0;
+
+	{
+		t_vec	v = lv_vec(4, sizeof(int));
+
+		for (int j = 0; j < 3; j++)
+			lv_vec_push(&v, &j, 1);
+		lv_vec_reserve(&v, 10);
+		assert(v.alloc_size >= 13 && v.size == 3);
+		lv_vec_reserve(&v, 0);
+		assert(v.alloc_size >= 13);
+		for (int j = 0; j < 3; j++)
+			assert(((int *)v.data)[j] == j);
+		lv_vec_free(&v);
+		printf("lv_vec_reserve passed tests: %lu\r", i++);
+	}
+	{
+		t_vec	v = lv_vec(2, sizeof(int));
+		t_vec	w = lv_vec(1, sizeof(int));
+
+		for (int j = 0; j < 5; j++)
+			lv_vec_push(&v, &j, 1);
+		lv_vec_extend_from(&w, &v);
+		assert(w.size == 5 && !memcmp(w.data, v.data, 5 * sizeof(int)));
+		lv_vec_extend_from(&v, &v);
+		lv_vec_extend_from(&v, &v);
+		assert(v.size == 20);
+		for (int j = 0; j < 20; j++)
+			assert(((int *)v.data)[j] == j % 5);
+		lv_vec_free(&v);
+		lv_vec_free(&w);
+		printf("lv_vec_extend_from passed tests: %lu\r", i++);
+	}
+	{
+		t_vec	v = lv_vec(4, sizeof(int));
+		int		fill = 7;
+
+		for (int j = 0; j < 10; j++)
+			lv_vec_push(&v, &j, 1);
+		lv_vec_resize(&v, 4, NULL);
+		assert(v.size == 4 && ((int *)v.data)[3] == 3);
+		assert(((int *)v.data)[4] == 0 && ((int *)v.data)[9] == 0);
+		lv_vec_resize(&v, 100, &fill);
+		assert(v.size == 100 && ((int *)v.data)[3] == 3);
+		for (int j = 4; j < 100; j++)
+			assert(((int *)v.data)[j] == 7);
+		lv_vec_resize(&v, 1000, NULL);
+		for (int j = 100; j < 1000; j++)
+			assert(((int *)v.data)[j] == 0);
+		lv_vec_resize(&v, 0, NULL);
+		assert(v.size == 0);
+		lv_vec_free(&v);
+		printf("lv_vec_resize passed tests: %lu\r", i++);
+	}
+	{
+		t_vec	v = lv_vec(4, sizeof(long));
+
+		for (long j = 0; j < 4; j++)
+			lv_vec_push(&v, &(long){j + 40}, 1);
+		lv_vec_resize(&v, 10000, v.data);
+		assert(v.size == 10000);
+		for (long j = 4; j < 10000; j++)
+			assert(((long *)v.data)[j] == 40);
+		lv_vec_resize(&v, 30000, (long *)v.data + 3);
+		for (long j = 10000; j < 30000; j++)
+			assert(((long *)v.data)[j] == 43);
+		lv_vec_free(&v);
+		printf("lv_vec_resize passed tests: %lu\r\n", i++);
+	}
+}
+
+static size_t	g_width;
+static size_t	g_compares;
+
+static int	cmp_u8(const void *a, const void *b)
+{
+	return ((*(const uint8_t *)a > *(const uint8_t *)b)
+		- (*(const uint8_t *)a < *(const uint8_t *)b));
+}
+
+static int	cmp_u16(const void *a, const void *b)
+{
+	return ((*(const uint16_t *)a > *(const uint16_t *)b)
+		- (*(const uint16_t *)a < *(const uint16_t *)b));
+}
+
+static int	cmp_u32(const void *a, const void *b)
+{
+	return ((*(const uint32_t *)a > *(const uint32_t *)b)
+		- (*(const uint32_t *)a < *(const uint32_t *)b));
+}
+
+static int	cmp_u64(const void *a, const void *b)
+{
+	return ((*(const uint64_t *)a > *(const uint64_t *)b)
+		- (*(const uint64_t *)a < *(const uint64_t *)b));
+}
+
+static int	cmp_bytes(const void *a, const void *b)
+{
+	return (memcmp(a, b, g_width));
+}
+
+/*
+ * McIlroy's adversary: values are frozen lazily, so that every pivot a
+ * quicksort picks is as bad as it can be. Sorting its output again
+ * replays the same worst case.
+ */
+
+static int		*g_val;
+static int		g_gas;
+static int		g_solid;
+static int		g_candidate;
+
+static int	cmp_adversary(const void *a, const void *b)
+{
+	int	x = *(const int *)a;
+	int	y = *(const int *)b;
+
+	if (g_val[x] == g_gas && g_val[y] == g_gas)
+		g_val[x == g_candidate ? x : y] = g_solid++;
+	if (g_val[x] == g_gas)
+		g_candidate = x;
+	else if (g_val[y] == g_gas)
+		g_candidate = y;
+	return ((g_val[x] > g_val[y]) - (g_val[x] < g_val[y]));
+}
+
+static int	cmp_counted(const void *a, const void *b)
+{
+	g_compares++;
+	return (cmp_u32(a, b));
+}
+
+static void	fill_pattern(t_u8 *p, size_t n, size_t w, int pattern,
+	int (*cmp)(const void *, const void *))
+{
+	uint64_t	x;
+
+	memset(p, 0, n * w);
+	for (size_t j = 0; j < n; j++)
+	{
+		x = (uint64_t)rand() << 31 ^ (uint64_t)rand();
+		if (pattern == 1)
+			x %= 3;
+		if (pattern == 4)
+			x = 42;
+		memcpy(p + j * w, &x, LV_MIN(w, sizeof(x)));
+	}
+	if (pattern == 2 || pattern == 3)
+		qsort(p, n, w, cmp);
+	if (pattern == 3)
+		lv_memrev(p, n, w);
+}
+
+void	vec_sort_tests()
+{
+	size_t	i = 0;
+	size_t	widths[] = {1, 2, 4, 8, 13};
+	int		(*cmps[])(const void *, const void *) = {cmp_u8, cmp_u16,
+		cmp_u32, cmp_u64, cmp_bytes};
+	size_t	sizes[] = {0, 1, 2, 15, 16, 17, 100, 1000, 20000};
+
+	for (size_t k = 0; k < 5; k++)
+	{
+		g_width = widths[k];
+		for (int pattern = 0; pattern < 5; pattern++)
+		{
+			for (size_t s = 0; s < sizeof(sizes) / sizeof(*sizes); s++)
+			{
+				t_vec	v = lv_vec(sizes[s] + 1, widths[k]);
+				t_u8	*ref = lv_alloc(sizes[s] * widths[k] + 1);
+
+				v.size = sizes[s];
+				fill_pattern(v.data, v.size, widths[k], pattern, cmps[k]);
+				memcpy(ref, v.data, v.size * widths[k]);
+				qsort(ref, v.size, widths[k], cmps[k]);
+				lv_vec_sort(&v, cmps[k]);
+				assert(!memcmp(v.data, ref, v.size * widths[k]));
+				lv_free((void **)&ref);
+				lv_vec_free(&v);
+			}
+		}
+		printf("lv_vec_sort passed tests: %lu\r", i++);
+	}
+	{
+		int		n = 4000;
+		t_vec	v = lv_vec((size_t)n, sizeof(int));
+
+		g_val = lv_alloc((size_t)n * sizeof(int));
+		g_gas = n;
+		g_solid = 0;
+		g_candidate = 0;
+		for (int j = 0; j < n; j++)
+		{
+			g_val[j] = g_gas;
+			lv_vec_push(&v, &j, 1);
+		}
+		lv_vec_sort(&v, cmp_adversary);
+		for (int j = 0; j < n; j++)
+			((int *)v.data)[j] = g_val[j];
+		g_compares = 0;
+		lv_vec_sort(&v, cmp_counted);
+		for (int j = 1; j < n; j++)
+			assert(((int *)v.data)[j - 1] <= ((int *)v.data)[j]);
+		assert(g_compares < (size_t)n * 100);
+		lv_free((void **)&g_val);
+		lv_vec_free(&v);
+		printf("lv_vec_sort passed tests: %lu\r", i++);
+	}
+	for (size_t k = 2; k < 4; k++)
+	{
+		for (int pattern = 0; pattern < 5; pattern++)
+		{
+			t_vec	v = lv_vec(30000, widths[k]);
+			t_u8	*ref = lv_alloc(30000 * widths[k]);
+
+			v.size = 30000;
+			fill_pattern(v.data, v.size, widths[k], pattern, cmps[k]);
+			memcpy(ref, v.data, v.size * widths[k]);
+			qsort(ref, v.size, widths[k], cmps[k]);
+			if (k == 2)
+				assert(lv_vec_radix_sort_u32(&v));
+			else
+				assert(lv_vec_radix_sort_u64(&v));
+			assert(!memcmp(v.data, ref, v.size * widths[k]));
+			lv_free((void **)&ref);
+			lv_vec_free(&v);
+		}
+		printf("lv_vec_radix_sort passed tests: %lu\r", i++);
+	}
+	for (size_t w = 8; w <= 16; w += 4)
+	{
+		t_vec		v = lv_vec(5000, w);
+		uint32_t	rec[4];
+
+		for (uint32_t j = 0; j < 5000; j++)
+		{
+			rec[0] = (uint32_t)rand() % 17;
+			rec[1] = j;
+			rec[2] = j;
+			lv_vec_push(&v, rec, 1);
+		}
+		assert(lv_vec_radix_sort_key_offset(&v, 0, 2));
+		for (size_t j = 1; j < v.size; j++)
+		{
+			uint32_t	*a = (uint32_t *)((t_u8 *)v.data + (j - 1) * w);
+			uint32_t	*b = (uint32_t *)((t_u8 *)v.data + j * w);
+
+			assert(a[0] < b[0] || (a[0] == b[0] && a[1] < b[1]));
+		}
+		assert(lv_vec_radix_sort_key_offset(&v, 4, 4));
+		for (size_t j = 0; j < v.size; j++)
+			assert(((uint32_t *)((t_u8 *)v.data + j * w))[1] == j);
+		lv_vec_free(&v);
+		printf("lv_vec_radix_sort passed tests: %lu\r", i++);
+	}
+	{
+		t_vec	v32 = lv_vec(4, sizeof(uint32_t));
+		t_vec	v64 = lv_vec(4, sizeof(uint64_t));
+
+		assert(!lv_vec_radix_sort_u32(NULL));
+		assert(!lv_vec_radix_sort_u32(&v64));
+		assert(!lv_vec_radix_sort_u64(&v32));
+		assert(lv_vec_radix_sort_u32(&v32) && lv_vec_radix_sort_u64(&v64));
+		assert(!lv_vec_radix_sort_key_offset(NULL, 0, 4));
+		assert(!lv_vec_radix_sort_key_offset(&v64, 0, 0));
+		assert(!lv_vec_radix_sort_key_offset(&v64, 0, 9));
+		assert(!lv_vec_radix_sort_key_offset(&v64, 5, 4));
+		assert(!lv_vec_radix_sort_key_offset(&v64, 9, 1));
+		assert(lv_vec_radix_sort_key_offset(&v64, 4, 4));
+		lv_vec_free(&v32);
+		lv_vec_free(&v64);
+		printf("lv_vec_radix_sort passed tests: %lu\r\n", i++);
+	}
+}
+
+static void	map_bump(void *elem, void *ctx)
+{
+	for (size_t b = 0; b < *(size_t *)ctx; b++)
+		((t_u8 *)elem)[b] += (t_u8)(b + 1);
+}
+
+static bool	keep_even(const void *elem, void *ctx)
+{
+	(void)ctx;
+	return (!(*(const t_u8 *)elem & 1));
+}
+
+static void	sum_first(void *acc, const void *elem, void *ctx)
+{
+	(void)ctx;
+	*(size_t *)acc += *(const t_u8 *)elem;
+}
+
+LV_VEC_DECL(int, ivec)
+
+static int	twice(int x)
+{
+	return (x * 2);
+}
+
+static bool	odd(int x)
+{
+	return (x & 1);
+}
+
+static int	add(int a, int b)
+{
+	return (a + b);
+}
+
+void	vec_algo_tests()
+{
+	size_t	i = 0;
+	size_t	widths[] = {1, 2, 4, 8, 12};
+
+	for (size_t k = 0; k < 5; k++)
+	{
+		size_t	w = widths[k];
+		size_t	n = 1001;
+		t_vec	v = lv_vec(n, w);
+		t_u8	*ref = lv_alloc(n * w);
+		size_t	kept = 0;
+		size_t	sum = 0;
+		size_t	acc = 0;
+
+		v.size = n;
+		for (size_t j = 0; j < n * w; j++)
+			((t_u8 *)v.data)[j] = (t_u8)(j * 7 + k);
+		memcpy(ref, v.data, n * w);
+		lv_vec_map(&v, map_bump, &w);
+		for (size_t j = 0; j < n * w; j++)
+			assert(((t_u8 *)v.data)[j] == (t_u8)(ref[j] + j % w + 1));
+		memcpy(ref, v.data, n * w);
+		for (size_t j = 0; j < n; j++)
+			sum += ref[j * w];
+		lv_vec_reduce(&v, &acc, sum_first, NULL);
+		assert(acc == sum);
+		for (size_t j = 0; j < n; j++)
+			if (!(ref[j * w] & 1))
+				memmove(ref + kept++ * w, ref + j * w, w);
+		assert(lv_vec_filter(&v, keep_even, NULL) == n - kept);
+		assert(v.size == kept && !memcmp(v.data, ref, kept * w));
+		for (size_t j = kept * w; j < n * w; j++)
+			assert(((t_u8 *)v.data)[j] == 0);
+		assert(lv_vec_filter(&v, keep_even, NULL) == 0);
+		lv_free((void **)&ref);
+		lv_vec_free(&v);
+		printf("lv_vec_map/filter/reduce passed tests: %lu\r", i++);
+	}
+	{
+		t_ivec	v = ivec_new(4);
+
+		for (int j = 0; j < 1000; j++)
+			ivec_push(&v, j);
+		ivec_map(&v, twice);
+		assert(v.data[999] == 1998);
+		assert(ivec_reduce(&v, 0, add) == 999000);
+		assert(ivec_filter(&v, odd) == 1000);
+		assert(v.size == 0 && v.data[0] == 0 && v.data[999] == 0);
+		for (int j = 0; j < 10; j++)
+			ivec_push(&v, j);
+		assert(ivec_filter(&v, odd) == 5);
+		assert(v.size == 5 && v.data[0] == 1 && v.data[4] == 9);
+		assert(v.data[5] == 0 && v.data[9] == 0);
+		assert(ivec_reduce(&v, 100, add) == 125);
+		ivec_free(&v);
+		printf("lv_vec_map/filter/reduce passed tests: %lu\r\n", i++);
+	}
+}
+
+void	vec_access_tests()
+{
+	size_t	i = 0;
+
+	{
+		t_vec	v = lv_vec(4, sizeof(int));
+		int		*c;
+
+		assert(!lv_vec_get(&v, 0) && !lv_vec_get_mut(&v, 0));
+		for (int j = 0; j < 10; j++)
+			lv_vec_push(&v, &j, 1);
+		assert(*(const int *)lv_vec_get(&v, 0) == 0);
+		assert(*(const int *)lv_vec_get(&v, 9) == 9);
+		assert(!lv_vec_get(&v, 10) && !lv_vec_get(&v, 11));
+		assert(!lv_vec_get_mut(&v, 10) && !lv_vec_get_clone(&v, 10));
+		assert(!lv_vec_get(NULL, 0) && !lv_vec_get_mut(NULL, 0));
+		*(int *)lv_vec_get_mut(&v, 9) = 90;
+		c = lv_vec_get_clone(&v, 9);
+		assert(c && *c == 90 && c != lv_vec_get(&v, 9));
+		lv_free((void **)&c);
+		lv_vec_free(&v);
+		printf("lv_vec_get passed tests: %lu\r", i++);
+	}
+	{
+		t_vec	v = lv_vec(4, sizeof(long));
+		t_vec	e = lv_vec(4, sizeof(long));
+		long	sum = 0;
+		size_t	n = 0;
+
+		for (long j = 0; j < 100; j++)
+			lv_vec_push(&v, &j, 1);
+		LV_VEC_AT(&v, long, 5) = 500;
+		assert(LV_VEC_AT(&v, long, 5) == 500 && LV_VEC_AT(&v, long, 99) == 99);
+		LV_VEC_FOREACH(&v, long, it)
+		{
+			sum += *it;
+			*it += 1;
+			n++;
+		}
+		assert(n == 100 && sum == 4950 - 5 + 500);
+		assert(LV_VEC_AT(&v, long, 0) == 1 && LV_VEC_AT(&v, long, 99) == 100);
+		LV_VEC_FOREACH(&e, long, it)
+			n++;
+		assert(n == 100);
+		lv_vec_free(&v);
+		lv_vec_free(&e);
+		printf("LV_VEC_AT/LV_VEC_FOREACH passed tests: %lu\r\n", i++);
+	}
+}
+
+typedef struct s_pt
+{
+	double	x;
+	double	y;
+}	t_pt;
+
+LV_VEC_DECL(t_pt, ptvec)
+
+static int	cmp_pt(const void *a, const void *b)
+{
+	return ((((const t_pt *)a)->x > ((const t_pt *)b)->x)
+		- (((const t_pt *)a)->x < ((const t_pt *)b)->x));
+}
+
+void	vec_typed_tests()
+{
+	size_t	i = 0;
+
+	{
+		t_ivec	v = ivec_new(2);
+		int		x = -1;
+
+		assert(v.size == 0 && v.alloc_size == 2 && v.sizeof_type == sizeof(int));
+		assert(!ivec_pop(&v, &x) && x == -1);
+		assert(!ivec_at(&v, 0));
+		for (int j = 0; j < 1000; j++)
+			assert(ivec_push(&v, j));
+		assert(v.size == 1000 && v.alloc_size >= 1000);
+		assert(ivec_get(&v, 0) == 0 && ivec_get(&v, 999) == 999);
+		assert(ivec_at(&v, 999) == v.data + 999 && !ivec_at(&v, 1000));
+		*ivec_at(&v, 10) = -10;
+		assert(ivec_pop(&v, &x) && x == 999 && v.size == 999);
+		assert(v.data[999] == 0);
+		assert(ivec_pop(&v, NULL) && v.size == 998);
+		assert(*(const int *)lv_vec_get(&v.vec, 10) == -10);
+		lv_vec_push(&v.vec, &x, 1);
+		assert(v.size == 999 && ivec_get(&v, 998) == 999);
+		lv_vec_rev(&v.vec);
+		assert(ivec_get(&v, 0) == 999 && ivec_get(&v, 988) == -10);
+		ivec_free(&v);
+		assert(!v.data && !v.size);
+		printf("LV_VEC_DECL passed tests: %lu\r", i++);
+	}
+	{
+		t_ptvec	v = ptvec_new(1);
+		t_ptvec	z = {0};
+		t_pt	p;
+
+		for (int j = 0; j < 100; j++)
+			assert(ptvec_push(&v, (t_pt){.x = 99 - j, .y = j}));
+		ptvec_sort(&v, cmp_pt);
+		assert(ptvec_get(&v, 0).x == 0 && ptvec_get(&v, 0).y == 99);
+		assert(ptvec_pop(&v, &p) && p.x == 99 && p.y == 0);
+		lv_vec_extend_from(&z.vec, &v.vec);
+		assert(z.size == 99 && z.sizeof_type == sizeof(t_pt));
+		assert(ptvec_get(&z, 98).x == 98);
+		assert(ptvec_push(&z, p) && ptvec_get(&z, 99).x == 99);
+		ptvec_free(&v);
+		ptvec_free(&z);
+		printf("LV_VEC_DECL passed tests: %lu\r\n", i++);
+	}
+}
+
+int main()
+{
+	vec_growth_tests();
+	vec_sort_tests();
+	vec_algo_tests();
+	vec_access_tests();
+	vec_typed_tests();
+	printf("[TESTER] All vec tests passed\n");
+	return (0);
+}